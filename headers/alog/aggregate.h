@@ -0,0 +1,48 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <alog/record.h>
+#include <alog/tools.h>
+
+namespace ALog {
+namespace Internal {
+
+// Per call-site statistics of ALOG_AGGREGATE: count, min, max, mean and approximate p99.
+// Constant-initialized, storage is allocated on first use. Values are accumulated in per-thread shards, without records.
+// Sites are never unregistered, so libraries containing them should not be unloaded.
+class AggregateSite
+{
+public:
+    struct Data;
+
+    constexpr AggregateSite(const char* name, const char* file, const char* fileOnly, int line)
+        : m_name(name), m_file(file), m_fileOnly(fileOnly), m_line(line) { }
+
+    template<typename ModuleFunc>
+    inline void add(double value, const char* func, const ModuleFunc& module) {
+        auto data = m_data.load(std::memory_order_acquire);
+        if (!data) data = registerSite(func, module());
+        addImpl(*data, value);
+    }
+
+    // Creates summary record for each site with samples since previous call and resets statistics
+    static void collect(Severity severity, const std::function<void(Record&&)>& func);
+
+private:
+    Data* registerSite(const char* func, const char* module);
+    static void addImpl(Data& data, double value);
+
+private:
+    const char* m_name;
+    const char* m_file;
+    const char* m_fileOnly;
+    int m_line;
+    std::atomic<Data*> m_data {};
+};
+
+} // namespace Internal
+} // namespace ALog
@@ -4,6 +4,8 @@
 
 #pragma once
 #include <alog/logger.h>
+#include <alog/config.h>
+#include <alog/config_watcher.h>
 
 #include <alog/adapters/all.h>
 //#include <alog/containers/all.h>
@@ -0,0 +1,45 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <vector>
+#include <alog/record.h>
+
+namespace ALog {
+
+// Collects records on producer side to publish them to logger in single operation (one lock, one wakeup).
+// Order is preserved. Submitting clears the batch. Not thread-safe.
+//   ALog::Batch batch;
+//   for (...) ALOG_BATCH(batch, ALog::Severity::Debug) << ...;
+//   ALOGGER += std::move(batch);
+class Batch
+{
+public:
+    Batch() = default;
+    explicit Batch(size_t capacity) { m_records.reserve(capacity); }
+
+    // Lazy arguments are evaluated here, because record outlives logging statement
+    void operator+= (Record&& record) {
+        if (record.hasLazyArgs())
+            record.resolveLazyArgs();
+
+        m_records.emplace_back(std::move(record));
+    }
+
+    bool empty() const { return m_records.empty(); }
+    size_t size() const { return m_records.size(); }
+    void clear() { m_records.clear(); }
+
+    std::vector<Record>& records() { return m_records; }
+    const std::vector<Record>& records() const { return m_records; }
+
+private:
+    std::vector<Record> m_records;
+};
+
+namespace Internal {
+inline const char* moduleOf(const Batch&) { return nullptr; }
+} // namespace Internal
+
+} // namespace ALog
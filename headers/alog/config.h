@@ -0,0 +1,96 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <alog/logger_impl.h>
+#include <alog/severity.h>
+#include <alog/sinks/console.h>
+
+namespace ALog {
+
+// Logger configuration in INI format. Lines starting with ';' or '#' are comments.
+//   [logger]                        Applied by apply() only
+//     mode                          sync, async, async-sort
+//     autoflush, producer_filtering true, false
+//   [levels]
+//     default                       verbose, debug, info, warning, error, fatal. Not set - everything passes
+//     <module>                      Same, takes precedence over default
+//   [filters]
+//     reject                        Comma-separated substrings, records containing any are rejected
+//     reject_regex                  Records matching it are rejected (see Filters::Regex)
+//     case_sensitive                true, false. For both
+//   [formatter]
+//     type                          default, minimal, json
+//     datetime, local_timestamp     Flags of default formatter
+//   [sink.<name>]                   Any number of sinks. Console sink, if none
+//     type                          console, file, file_rotated
+//     stream, colors                Console: stdout, stderr; auto, force, disable
+//     path, create_path             File and file_rotated
+//     max_size, max_age, max_count  File_rotated: bytes, days, files
+// Example:
+//   [levels]
+//   default = info
+//   Network = debug
+//
+//   [sink.main]
+//   type = file_rotated
+//   path = logs/app.log
+//   max_size = 10485760
+struct Config
+{
+    enum class FormatterType { Default, Minimal, Json };
+
+    struct Sink {
+        enum class Type { Console, File, FileRotated };
+
+        std::string name;
+        Type type { Type::Console };
+        Sinks::Console::Stream stream { Sinks::Console::Stream::StdOut };
+        Sinks::Console::ColorMode colors { Sinks::Console::ColorMode::Auto };
+        std::string path;
+        bool createPath {};
+        std::optional<size_t> maxSize;  // Bytes
+        std::optional<size_t> maxAge;   // Days
+        std::optional<size_t> maxCount;
+    };
+
+    std::optional<Logger::LoggerMode> mode;
+    std::optional<bool> autoflush;
+    std::optional<bool> producerFiltering;
+
+    std::optional<Severity> defaultLevel;                    // Empty - everything passes
+    std::vector<std::pair<std::string, Severity>> moduleLevels;
+
+    std::vector<std::string> reject;
+    std::string rejectRegex;
+    bool caseSensitive { true };
+
+    FormatterType formatter { FormatterType::Default };
+    bool dateTime { true };
+    bool localTimestamp { true };
+
+    std::vector<Sink> sinks;
+
+    // Throws std::invalid_argument with line number on malformed text
+    static Config parse(const std::string& text);
+
+    // Throws std::runtime_error if file can't be read, std::invalid_argument on malformed text
+    static Config load(const std::string& fileName);
+
+    // Fills 'pipeline' from scratch. Throws if filter or sink can't be created.
+    void createPipeline(Sinks::Pipeline& pipeline) const;
+
+    // Thread-safe. Replaces pipeline of 'logger' (see Logger::reconfigure), unchanged if pipeline can't be created.
+    void applyPipeline(Logger& logger) const;
+
+    // Pipeline and [logger] options. Not thread-safe, intended for startup.
+    void apply(Logger& logger) const;
+};
+
+} // namespace ALog
@@ -0,0 +1,43 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <alog/config.h>
+
+namespace ALog {
+
+// Reapplies pipeline from configuration file (see Config::applyPipeline) when it changes.
+// Previous configuration stays active if file is malformed, 'onError' is called then (its exceptions are ignored).
+// Linux: inotify on containing directory, so files replaced by rename are handled too. Polling if it fails.
+// Other platforms: modification time and size are polled every 'pollInterval'.
+class ConfigWatcher
+{
+    ALOG_NO_COPY_MOVE(ConfigWatcher);
+public:
+    using ErrorHandler = std::function<void(const std::string& error)>;
+
+    ConfigWatcher(Logger& logger,
+                  const std::string& fileName,
+                  ErrorHandler onError = {},
+                  std::chrono::milliseconds pollInterval = std::chrono::milliseconds(500));
+    ~ConfigWatcher();
+
+    // Thread-safe. Returns false if configuration wasn't applied
+    bool reload();
+
+    // Count of successful reloads
+    uint64_t reloads() const;
+
+private:
+    void threadFunc();
+
+private:
+    ALOG_DECLARE_PIMPL
+};
+
+} // namespace ALog
@@ -0,0 +1,54 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <memory>
+#include <optional>
+#include <alog/record.h>
+#include <alog/tools.h>
+
+namespace ALog {
+
+// Adds key/value to diagnostic context of current thread for the scope lifetime.
+// Records created within the scope share the context (no formatting on producer side),
+// formatters render it. Key should be literal.
+class ScopedContext
+{
+    ALOG_NO_COPY_MOVE(ScopedContext);
+public:
+    template<typename T>
+    ScopedContext(const char* key, const T& value) { push(Record::Field::create(key, value)); }
+    ~ScopedContext();
+
+private:
+    void push(const Record::Field& value);
+
+private:
+    std::shared_ptr<const Record::Context> m_previous;
+};
+
+// Makes severity filters (Filters::Severity, SeverityModule, SeverityFile) pass records of current thread
+// with at least given severity, for the scope lifetime. Can only lower the thresholds.
+// Compile-time stripping (ALOG_MIN_SEVERITY) is not affected.
+class ScopedVerbosity
+{
+    ALOG_NO_COPY_MOVE(ScopedVerbosity);
+public:
+    ScopedVerbosity(Severity severity);
+    ~ScopedVerbosity();
+
+private:
+    std::optional<Severity> m_previous;
+};
+
+namespace Internal {
+const std::shared_ptr<const Record::Context>& currentContext();
+std::optional<Severity> currentVerbosity();
+} // namespace Internal
+
+} // namespace ALog
+
+#define ALOG_CONTEXT_IMPL2(key, value, line) ALog::ScopedContext alogContext##line{key, value}
+#define ALOG_CONTEXT_IMPL(key, value, line)  ALOG_CONTEXT_IMPL2(key, value, line)
+#define ALOG_CONTEXT(key, value)             ALOG_CONTEXT_IMPL(key, value, __LINE__)
@@ -0,0 +1,113 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ALog {
+
+// Customization point: enums with names table. Use ALOG_ENUM_NAMES or ALOG_ENUM_REFLECT to specialize.
+template<typename T>
+struct EnumNames : std::false_type { };
+
+namespace Internal {
+
+// Scoped enums and enums with fixed underlying type: any value of underlying type is valid, so can be reflected
+template<typename T, typename = void>
+struct has_fixed_underlying_type : std::false_type { };
+
+template<typename T>
+struct has_fixed_underlying_type<T, std::void_t<decltype(T{std::underlying_type_t<T>{}})>> : std::true_type { };
+
+// Value -> name table of enum, built once. Lookup is array access for compact enums, binary search otherwise.
+class EnumTable
+{
+public:
+    struct Entry {
+        int64_t value;
+        const char* name; // Not necessarily null-terminated
+        size_t len;
+    };
+
+    EnumTable(const char* typeName, std::vector<Entry> entries);
+
+    template<typename T>
+    [[nodiscard]] static EnumTable create(const char* typeName, std::initializer_list<std::pair<T, const char*>> entries) {
+        std::vector<Entry> result;
+        result.reserve(entries.size());
+        for (const auto& x : entries)
+            result.push_back({static_cast<int64_t>(x.first), x.second, strlen(x.second)});
+        return EnumTable(typeName, std::move(result));
+    }
+
+    // Names are extracted from compiler's function signature, for values in [Min, Max]
+    template<typename T, int64_t Min, int64_t Max>
+    [[nodiscard]] static EnumTable reflect(const char* typeName) {
+        static_assert(has_fixed_underlying_type<T>::value, "ALOG_ENUM_REFLECT: enum should be scoped or have fixed underlying type");
+        static_assert(Min <= Max && Max - Min < 1024, "ALOG_ENUM_REFLECT: range is too large");
+        std::vector<Entry> result;
+        reflectImpl<T, Min>(result, std::make_integer_sequence<int64_t, Max - Min + 1>());
+        return EnumTable(typeName, std::move(result));
+    }
+
+    const char* typeName() const { return m_typeName; }
+    size_t typeNameLen() const { return m_typeNameLen; }
+
+    template<typename T>
+    const Entry* find(T value) const { return findImpl(static_cast<int64_t>(value)); }
+
+private:
+    const Entry* findImpl(int64_t value) const;
+
+    template<typename T, int64_t Min, int64_t... Is>
+    static void reflectImpl(std::vector<Entry>& result, std::integer_sequence<int64_t, Is...>) {
+        (addReflected(result, Min + Is, enumSignature<T, static_cast<T>(Min + Is)>()), ...);
+    }
+
+    template<typename T, T Value>
+    static const char* enumSignature() {
+#ifdef _MSC_VER
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
+
+    static void addReflected(std::vector<Entry>& result, int64_t value, const char* signature);
+
+private:
+    const char* m_typeName;
+    size_t m_typeNameLen;
+    std::vector<Entry> m_entries;  // Sorted by value
+    std::vector<int32_t> m_dense;  // Index in m_entries by (value - min), -1 - none. Empty if range is too big
+};
+
+} // namespace Internal
+} // namespace ALog
+
+// Register enum names (at global namespace, before logging the enum):
+//   ALOG_ENUM_NAMES(MyNs::Color, {MyNs::Color::Red, "Red"}, {MyNs::Color::Green, "Green"});
+#define ALOG_ENUM_NAMES(Type, ...) \
+    template<> struct ALog::EnumNames<Type> : std::true_type { \
+        static const ALog::Internal::EnumTable& table() { \
+            static const auto instance = ALog::Internal::EnumTable::create<Type>(#Type, {__VA_ARGS__}); \
+            return instance; \
+        } \
+    }
+
+// Extract enum names of values in [Min, Max] from compiler's function signature (at global namespace).
+// Enum should be scoped or have fixed underlying type, otherwise values out of its range are ill-formed:
+//   ALOG_ENUM_REFLECT(MyNs::Color, 0, 10);
+#define ALOG_ENUM_REFLECT(Type, Min, Max) \
+    template<> struct ALog::EnumNames<Type> : std::true_type { \
+        static const ALog::Internal::EnumTable& table() { \
+            static const auto instance = ALog::Internal::EnumTable::reflect<Type, Min, Max>(#Type); \
+            return instance; \
+        } \
+    }
@@ -4,6 +4,7 @@
 
 #pragma once
 #include <memory>
+#include <string>
 #include <vector>
 #include <functional>
 #include <alog/record.h>
@@ -25,6 +26,18 @@ public:
         UndefinedIsReject = 2048,
     };
 
+    enum Dependency {
+        DependsOnSeverity = 1,
+        DependsOnModule = 2,
+        DependsOnFile = 4,
+        DependsOnMessage = 8,
+        DependsOnFields = 16,
+        DependsOnOther = 32,
+        DependsOnSampleKey = 64,
+
+        DependsOnAnything = 127
+    };
+
     IFilter(Mode mode = PassOrReject): m_mode(mode) { };
     IFilter(const IFilter&) = delete;
     IFilter& operator=(const IFilter&) = delete;
@@ -32,6 +45,19 @@ public:
     virtual ~IFilter() = default;
     virtual I::optional_bool canPass(const Record& record) const;
 
+    // Record data the decision is based on (Dependency mask). Filters which don't depend
+    // on message or 'other' data may be evaluated early in producer thread and should be thread-safe.
+    virtual int dependencies() const { return DependsOnAnything; }
+
+    struct TableKeys {
+        std::vector<std::string> modules;
+        std::vector<std::string> files;
+    };
+
+    // Filters, which decide by severity, module and file only, return true and add compared names to 'keys'.
+    // Chains of such filters are compiled to decision table (see Filters::Chain). Filter should be immutable then.
+    virtual bool collectTableKeys(TableKeys& keys) const { (void)keys; return false; }
+
 protected:
     virtual I::optional_bool canPassImpl(const Record& record) const { (void)record; return {}; };
 
@@ -47,19 +73,40 @@ using IFilterPtr = std::shared_ptr<IFilter>;
 namespace ALog {
 namespace Filters {
 
+// First defined decision of items wins.
+// If all items support it (see IFilter::collectTableKeys), chain is compiled to table (module x file x severity -> decision)
+// on each change, and records created by logging macros are decided by single lookup.
+// Nested chains may change after being added, so chain containing them isn't compiled.
 class Chain : public IFilter, public Internal::IChain<IFilter, Chain>
 {
 public:
-    using Internal::IChain<IFilter, Chain>::IChain;
+    Chain();
+    Chain(const std::initializer_list<IFilterPtr>& filters);
+    ~Chain() override;
 
-    void setDefaultDecision(bool value) { m_defaultDecision = value; }
+    void setDefaultDecision(bool value) { m_defaultDecision = value; changed(); }
 
     I::optional_bool canPass(const Record& record) const override;
+    int dependencies() const override;
 
     void clear() override;
 
+protected:
+    Chain(bool compiled, const std::initializer_list<IFilterPtr>& filters = {}); // For chains with own logic, which override onChanged
+    void onChanged() override { compile(); }
+
+private:
+    struct Table;
+
+    bool evaluate(const Record& record) const;
+    bool collectItemsKeys(TableKeys& keys) const;
+    void compile();
+
 protected:
     bool m_defaultDecision { true };
+
+private:
+    std::unique_ptr<const Table> m_table;
 };
 
 
@@ -69,13 +116,16 @@ public:
     using Chain_OR_Ptr = std::shared_ptr<Chain_OR>;
 
 public:
-    using Chain::Chain;
+    Chain_OR(): Chain(false) { }
+    Chain_OR(const std::initializer_list<IFilterPtr>& filters): Chain(false, filters) { }
 
     template<typename... Args>
     [[nodiscard]] static Chain_OR_Ptr create(Args... args) { return std::make_shared<Chain_OR>(std::forward<Args>(args)...); }
     [[nodiscard]] static Chain_OR_Ptr create(const std::initializer_list<IFilterPtr>& filters) { return std::make_shared<Chain_OR>(filters); }
 
     I::optional_bool canPass(const Record& record) const override;
+protected:
+    void onChanged() override { } // Not compiled
 };
 
 
@@ -85,13 +135,16 @@ public:
     using Chain_AND_Ptr = std::shared_ptr<Chain_AND>;
 
 public:
-    using Chain::Chain;
+    Chain_AND(): Chain(false) { }
+    Chain_AND(const std::initializer_list<IFilterPtr>& filters): Chain(false, filters) { }
 
     template<typename... Args>
     [[nodiscard]] static Chain_AND_Ptr create(Args... args) { return std::make_shared<Chain_AND>(std::forward<Args>(args)...); }
     [[nodiscard]] static Chain_AND_Ptr create(const std::initializer_list<IFilterPtr>& filters) { return std::make_shared<Chain_AND>(filters); }
 
     I::optional_bool canPass(const Record& record) const override;
+protected:
+    void onChanged() override { } // Not compiled
 };
 
 
@@ -101,13 +154,16 @@ public:
     using Chain_NOR_Ptr = std::shared_ptr<Chain_NOR>;
 
 public:
-    using Chain::Chain;
+    Chain_NOR(): Chain(false) { }
+    Chain_NOR(const std::initializer_list<IFilterPtr>& filters): Chain(false, filters) { }
 
     template<typename... Args>
     [[nodiscard]] static Chain_NOR_Ptr create(Args... args) { return std::make_shared<Chain_NOR>(std::forward<Args>(args)...); }
     [[nodiscard]] static Chain_NOR_Ptr create(const std::initializer_list<IFilterPtr>& filters) { return std::make_shared<Chain_NOR>(filters); }
 
     I::optional_bool canPass(const Record& record) const override;
+protected:
+    void onChanged() override { } // Not compiled
 };
 
 
@@ -135,6 +191,8 @@ class Always : public IFilter
 public:
     Always(I::optional_bool pass): m_pass(pass) { }
     I::optional_bool canPass(const Record&) const override { return m_pass; }
+    int dependencies() const override { return 0; }
+    bool collectTableKeys(TableKeys&) const override { return true; }
 
 private:
     I::optional_bool m_pass;
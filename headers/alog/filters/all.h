@@ -9,3 +9,7 @@
 #include <alog/filters/module.h>
 #include <alog/filters/file.h>
 #include <alog/filters/substring.h>
+#include <alog/filters/multi_substring.h>
+#include <alog/filters/regex.h>
+#include <alog/filters/field.h>
+#include <alog/filters/hash_sample.h>
@@ -0,0 +1,33 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <functional>
+#include <alog/filter.h>
+
+namespace ALog {
+namespace Filters {
+
+// Matches structured field (see ALOG_FIELD) by predicate.
+// Decision is undefined for records without such field.
+class Field : public IFilter
+{
+    ALOG_NO_COPY_MOVE(Field);
+public:
+    using Predicate = std::function<bool(const Record::Field&)>;
+
+    Field(const char* name, const Predicate& predicate, bool pass = true, Mode mode = PassOrReject);
+    ~Field() override;
+
+    int dependencies() const override { return DependsOnFields; }
+
+protected:
+    I::optional_bool canPassImpl(const Record& record) const override;
+
+private:
+    ALOG_DECLARE_PIMPL
+};
+
+} // namespace Filters
+} // namespace ALog
@@ -14,6 +14,9 @@ public:
     File(const char* file, bool pass = true, Mode mode = PassOrReject);
     ~File() override;
 
+    int dependencies() const override { return DependsOnFile; }
+    bool collectTableKeys(TableKeys& keys) const override;
+
 protected:
     I::optional_bool canPassImpl(const Record& record) const override;
 
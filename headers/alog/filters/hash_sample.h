@@ -0,0 +1,36 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <cstdint>
+#include <alog/filter.h>
+
+namespace ALog {
+namespace Filters {
+
+// Keeps 'rate' (0..1) fraction of sample keys (see ALOG_SAMPLE_KEY), all records of kept key pass.
+// Decision depends on key and seed only, so it's the same in all threads, processes and hosts.
+// Decision is undefined for records without key. Evaluated early, in producer thread.
+class HashSample : public IFilter
+{
+    ALOG_NO_COPY_MOVE(HashSample);
+public:
+    HashSample(double rate, uint64_t seed = 0, Mode mode = PassOrReject);
+    ~HashSample() override;
+
+    int dependencies() const override { return DependsOnSampleKey; }
+
+    // Same decision for gating statements at call site, before record is built:
+    //   LOGD_IF(ALog::Filters::HashSample::keep(requestId, 0.01)) << ...;
+    static bool keep(uint64_t key, double rate, uint64_t seed = 0);
+
+protected:
+    I::optional_bool canPassImpl(const Record& record) const override;
+
+private:
+    ALOG_DECLARE_PIMPL
+};
+
+} // namespace Filters
+} // namespace ALog
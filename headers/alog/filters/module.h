@@ -14,6 +14,9 @@ public:
     Module(const char* module, bool pass = true, Mode mode = PassOrReject);
     ~Module() override;
 
+    int dependencies() const override { return DependsOnModule; }
+    bool collectTableKeys(TableKeys& keys) const override;
+
 protected:
     I::optional_bool canPassImpl(const Record& record) const override;
 
@@ -0,0 +1,36 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <alog/filter.h>
+
+namespace ALog {
+namespace Filters {
+
+// Matches if message contains any of patterns. All patterns are found in one pass over message
+// (Aho-Corasick automaton, built in constructor). Case-insensitive mode folds ASCII letters.
+// Empty patterns are ignored.
+class MultiSubstring : public IFilter
+{
+    ALOG_NO_COPY_MOVE(MultiSubstring);
+public:
+    MultiSubstring(const std::vector<std::string>& patterns, bool pass = true,
+                   bool caseSensitive = true, Mode mode = PassOrReject);
+    ~MultiSubstring() override;
+
+    int dependencies() const override { return DependsOnMessage; }
+
+    bool contains(const char* str, size_t len) const;
+
+protected:
+    I::optional_bool canPassImpl(const Record& record) const override;
+
+private:
+    ALOG_DECLARE_PIMPL
+};
+
+} // namespace Filters
+} // namespace ALog
@@ -0,0 +1,39 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <alog/filter.h>
+
+namespace ALog {
+namespace Filters {
+
+// Matches if message contains match of regular expression. Pattern is compiled to DFA in constructor,
+// message is checked in one pass without allocations.
+// Supported subset (bytes, ECMAScript-like syntax):
+//   literals and escapes (\t \n \r \f \v \0 \xHH, escaped punctuation), '.' (except '\n'),
+//   classes [a-z_] [^...] \d \w \s \D \W \S, groups (...) (?:...), alternation |,
+//   repetitions * + ? {n} {n,} {n,m} (lazy forms too), anchors ^ $ (start and end of message).
+// Captures, backreferences, lookarounds and word boundaries aren't supported.
+// Throws std::invalid_argument on malformed, unsupported or too complex pattern.
+class Regex : public IFilter
+{
+    ALOG_NO_COPY_MOVE(Regex);
+public:
+    Regex(const char* pattern, bool pass = true,
+          bool caseSensitive = true, Mode mode = PassOrReject);
+    ~Regex() override;
+
+    int dependencies() const override { return DependsOnMessage; }
+
+    bool matches(const char* str, size_t len) const;
+
+protected:
+    I::optional_bool canPassImpl(const Record& record) const override;
+
+private:
+    ALOG_DECLARE_PIMPL
+};
+
+} // namespace Filters
+} // namespace ALog
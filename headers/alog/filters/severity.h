@@ -16,6 +16,8 @@ public:
           m_comparison(comparison)
     { }
 
+    int dependencies() const override { return DependsOnSeverity; }
+    bool collectTableKeys(TableKeys& keys) const override;
 
 protected:
     I::optional_bool canPassImpl(const Record& record) const override;
@@ -17,6 +17,9 @@ public:
                  ALog::Comparison1 comparison = ALog::GreaterEqual);
     ~SeverityFile() override;
 
+    int dependencies() const override { return DependsOnSeverity | DependsOnFile; }
+    bool collectTableKeys(TableKeys& keys) const override;
+
 protected:
     I::optional_bool canPassImpl(const Record& record) const override;
 
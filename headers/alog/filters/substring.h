@@ -16,6 +16,8 @@ public:
               bool caseSensitive = true, Mode mode = PassOrReject);
     ~Substring() override;
 
+    int dependencies() const override { return DependsOnMessage; }
+
 protected:
     I::optional_bool canPassImpl(const Record& record) const override;
 
@@ -5,3 +5,4 @@
 #pragma once
 #include <alog/formatters/default.h>
 #include <alog/formatters/minimal.h>
+#include <alog/formatters/json.h>
@@ -0,0 +1,19 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <alog/formatter.h>
+
+namespace ALog {
+namespace Formatters {
+
+// One JSON object per record. Structured fields and diagnostic context are written as "fields" and "context" objects
+class Json : public IFormatter
+{
+public:
+    Buffer format(const Record& record) const override;
+};
+
+} // namespace Formatters
+} // namespace ALog
@@ -5,16 +5,86 @@
 #pragma once
 #include <mutex>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <alog/logger_impl.h>
+#include <alog/context.h>
+#include <alog/sites.h>
+#include <alog/signal_safe.h>
+#include <alog/aggregate.h>
+#include <alog/prepared.h>
 
 // Notes
 // - To disable short macros (LOGW, LOGW_IF, FLUSH, ...) and declare
 //   original only (ALOGW, ALOGW_IF, ALOG_FL_FLUSH, ...) do
 //   #define ALOG_NO_SHORT_MACROS
+// - To strip statements below some severity at compile time do
+//   #define ALOG_MIN_SEVERITY <0..5>  (or set CMake option ALOG_MIN_SEVERITY)
+//   Stripped statements don't evaluate their arguments and leave no code or
+//   string literals in the binary. Assertions are never stripped.
+// - To build records without separators/auto quotes support (no runtime flag checks) do
+//   #define ALOG_RECORD_POLICY ALog::RecordPolicy::Plain
+//   or use ALOG_RECORD_POLICY_IMPL(ALog::RecordPolicy::Plain, Severity) in own macro family
 
 namespace ALog {
 
-struct MockRecord { };
+struct MockRecord
+{
+    template<typename... Args> MockRecord&& seps(Args&&...) { return static_cast<MockRecord&&>(*this); }
+    MockRecord&& no_seps() { return static_cast<MockRecord&&>(*this); }
+    MockRecord&& quotes() { return static_cast<MockRecord&&>(*this); }
+    MockRecord&& no_quotes() { return static_cast<MockRecord&&>(*this); }
+};
+
+namespace Internal {
+
+// Per call-site state of sampling macros (ALOGx_EVERY_N, ALOGx_FIRST_N, ALOGx_EVERY_MS).
+// Constant-initialized, so no static guard is involved.
+class SamplingSite
+{
+public:
+    struct Decision {
+        bool skip;
+        uint64_t suppressed; // Occurrences skipped since previous emitted record
+        explicit operator bool() const { return skip; }
+    };
+
+    constexpr SamplingSite() = default;
+
+    inline Decision everyN(uint64_t n) {
+        const auto index = m_counter.fetch_add(1, std::memory_order_relaxed);
+        if (n <= 1) return {false, 0};
+        if (index % n) return {true, 0};
+        return {false, index ? n - 1 : 0};
+    }
+
+    inline Decision firstN(uint64_t n) {
+        if (m_counter.load(std::memory_order_relaxed) >= n) return {true, 0};
+        return {m_counter.fetch_add(1, std::memory_order_relaxed) >= n, 0};
+    }
+
+    // Suppressed count is approximate under concurrent access
+    inline Decision everyMs(int64_t ms) {
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() + 1;
+        auto last = m_lastMs.load(std::memory_order_relaxed);
+
+        if ((last && now - last < ms) ||
+            !m_lastMs.compare_exchange_strong(last, now, std::memory_order_relaxed))
+        {
+            m_counter.fetch_add(1, std::memory_order_relaxed);
+            return {true, 0};
+        }
+
+        return {false, m_counter.exchange(0, std::memory_order_relaxed)};
+    }
+
+private:
+    std::atomic<uint64_t> m_counter {0};
+    std::atomic<int64_t> m_lastMs {0}; // 0 - never emitted
+};
+
+} // namespace Internal
 
 template<int Number = 0>
 class LoggerN : public Logger { };
@@ -30,6 +100,7 @@ public:
 
     LoggerEntry(const char* module = nullptr) {
         m_module = module;
+        m_moduleId = I::internModule(module);
         m_masterAvailable = this->available();
     }
 
@@ -37,8 +108,34 @@ public:
         *this += Record::create(ALog::Record::Flags::FlushAndDrop);
     }
 
+    const char* module() const { return m_module; }
+
+    // Async-signal-safe. Record is dropped if logger isn't ready yet
+    void operator+= (SignalRecord&& record) noexcept {
+        record.module = m_module;
+        if (m_masterAvailable)
+            this->fastGet()->addSignalRecord(record);
+    }
+
+    void operator+= (Batch&& batch) {
+        for (auto& x : batch.records()) {
+            x.module = m_module;
+            x.moduleId = m_moduleId;
+        }
+
+        if (m_masterAvailable) {
+            this->fastGet()->addRecords(std::move(batch));
+            return;
+        }
+
+        auto _clear = I::CreateFinally([&batch](){ batch.clear(); });
+        for (auto& x : batch.records())
+            *this += std::move(x);
+    }
+
     void operator+= (Record&& record) {
         record.module = m_module;
+        record.moduleId = m_moduleId;
 
         // Lock-free optimization
         if (m_masterAvailable) {
@@ -55,6 +152,9 @@ public:
 
         } else {
             // Add record to queue
+            if (record.hasLazyArgs())
+                record.resolveLazyArgs();
+
             I::LongSSO<> message;
             bool abort { false };
             bool throwMe { false };
@@ -90,12 +190,30 @@ public:
 private:
     std::mutex m_mutex;
     const char* m_module { nullptr };
+    uint16_t m_moduleId {};
     bool m_masterAvailable { false };
     std::vector<Record> m_queue;
 };
 
 using DefaultLogger = ALog::LoggerHolder<0>;
 
+namespace Internal {
+// Access to main logger from signal handlers: no ref-counting, no locks
+template<int Number>
+struct SignalMainLogger
+{
+    void operator+= (const SignalRecord& record) noexcept {
+        using Holder = LoggerHolder<Number>;
+        if (Holder::exists() && Holder::instance()->isReady())
+            (*Holder::instance())->addSignalRecord(record);
+    }
+};
+
+inline const char* moduleOf(const Logger&) { return nullptr; }
+template<int Number>
+inline const char* moduleOf(const LoggerEntry<Number>& entry) { return entry.module(); }
+} // namespace Internal
+
 } // namespace ALog
 
 template<typename T>
@@ -130,20 +248,121 @@ inline ALog::MockRecord&& operator<< (ALog::MockRecord&& r, const T&) { return s
 #define ACCESS_ALOGGER_MODULE          ACCESS_ALOGGER_MODULE_N(0)
 
 
-#define ALOG_RECORD_IMPL(Severity)          ALog::Record::create(Severity, __LINE__, __FILE__, ALog::I::extractFileNameOnly(__FILE__), __func__)
-#define ALOG_IMPL(Logger, Severity)         Logger += ALOG_RECORD_IMPL(Severity)
+#ifndef ALOG_RECORD_POLICY
+#define ALOG_RECORD_POLICY                  ALog::RecordPolicy::Dynamic
+#endif
+
+#define ALOG_RECORD_POLICY_IMPL(Policy, Severity) Policy::Type::create(Severity, __LINE__, __FILE__, ALog::I::extractFileNameOnly(__FILE__), __func__)
+#define ALOG_RECORD_IMPL(Severity)          ALOG_RECORD_POLICY_IMPL(ALOG_RECORD_POLICY, Severity)
+#define ALOG_SITE_IMPL(Logger, Severity) \
+    if (static ALog::I::Site alogSite {__FILE__, __LINE__}; \
+        const auto alogSiteState = alogSite.check(Severity, __func__, [&]{ return ALog::I::moduleOf(Logger); })) {;} \
+    else
+#define ALOG_IMPL(Logger, Severity)         ALOG_SITE_IMPL(Logger, Severity) Logger += ALog::I::Site::apply(ALOG_RECORD_IMPL(Severity), alogSiteState)
+
 
+#define ALOG_BATCH(Batch, Severity)      ALOG_IMPL(Batch, Severity)
 
 #define ALOG_MODULE(Severity)            ALOG_IMPL(ACCESS_ALOGGER_MODULE, Severity)
 #define ALOG_MODULE_N(N, Severity)       ALOG_IMPL(ACCESS_ALOGGER_MODULE_N(N), Severity)
 #define ALOG_MAIN(Severity)              ALOG_IMPL(ALOGGER, Severity)
 #define ALOG_MAIN_N(N, Severity)         ALOG_IMPL(ALOGGER_N(N), Severity)
 
+// Async-signal-safe statements, see ALog::SignalRecord. Not affected by ALog::Sites
+#define ALOG_SIGNAL_RECORD_IMPL(Severity) ALog::SignalRecord::create(Severity, __LINE__, __FILE__, ALog::I::extractFileNameOnly(__FILE__), __func__)
+#define ALOG_MODULE_SIGNAL(Severity)     ACCESS_ALOGGER_MODULE += ALOG_SIGNAL_RECORD_IMPL(Severity)
+#define ALOG_MAIN_SIGNAL(Severity)       ALog::I::SignalMainLogger<0>() += ALOG_SIGNAL_RECORD_IMPL(Severity)
+
+// Prepared statements (see ALog::PreparedStatement). Severity is name only (Info, Warning, ...), fragments should be
+// constants; '_' marks argument slot. Record is located at LOG_PREPARED
+#define ALOG_PREPARE(SeverityName, ...) \
+    ALOG_PREPARE_GATE_##SeverityName( \
+        [](const ALog::I::Preparer& alogPreparer){ using ALog::Placeholders::_; return alogPreparer(__VA_ARGS__); } \
+            (ALog::I::Preparer{ALog::Severity::SeverityName}))
+#define ALOG_PREPARED_IMPL(Logger, Stmt, ...) \
+    if constexpr (ALog::I::isStrippedStatement<decltype(Stmt)>) {;} else \
+    ALOG_SITE_IMPL(Logger, (Stmt).severity()) \
+    Logger += ALog::I::Site::apply((Stmt).at(__LINE__, __FILE__, ALog::I::extractFileNameOnly(__FILE__), __func__).record(__VA_ARGS__), alogSiteState)
+
+// Statistics of Value per call-site, emitted periodically by logger (see Logger::setAggregation). Name should be literal
+#define ALOG_AGGREGATE_IMPL(Logger, Name, Value) \
+    do { \
+        static ALog::I::AggregateSite alogAggregateSite {Name, __FILE__, ALog::I::extractFileNameOnly(__FILE__), __LINE__}; \
+        alogAggregateSite.add(static_cast<double>(Value), __func__, [&]{ return ALog::I::moduleOf(Logger); }); \
+    } while (false)
+
 #define ALOG_MODULE_IF(Cond, Severity)        if (!(Cond)) {;} else ALOG_IMPL(ACCESS_ALOGGER_MODULE, Severity)
 #define ALOG_MODULE_IF_N(N, Cond, Severity)   if (!(Cond)) {;} else ALOG_IMPL(ACCESS_ALOGGER_MODULE_N(N), Severity)
 #define ALOG_MAIN_IF(Cond, Severity)          if (!(Cond)) {;} else ALOG_IMPL(ALOGGER, Severity)
 #define ALOG_MAIN_IF_N(N, Cond, Severity)     if (!(Cond)) {;} else ALOG_IMPL(ALOGGER_N(N), Severity)
 
+#define ALOG_SAMPLED_IMPL(Logger, Severity, Method, Arg) \
+    ALOG_SITE_IMPL(Logger, Severity) \
+    if (static ALog::I::SamplingSite alogSamplingSite; const auto alogSampling = alogSamplingSite.Method(Arg)) {;} \
+    else Logger += ALog::I::Site::apply(ALOG_RECORD_IMPL(Severity).set_suppressed(alogSampling.suppressed), alogSiteState)
+
+#define ALOG_MODULE_EVERY_N(Count, Severity)  ALOG_SAMPLED_IMPL(ACCESS_ALOGGER_MODULE, Severity, everyN, Count)
+#define ALOG_MODULE_FIRST_N(Count, Severity)  ALOG_SAMPLED_IMPL(ACCESS_ALOGGER_MODULE, Severity, firstN, Count)
+#define ALOG_MODULE_EVERY_MS(Ms, Severity)    ALOG_SAMPLED_IMPL(ACCESS_ALOGGER_MODULE, Severity, everyMs, Ms)
+#define ALOG_MAIN_EVERY_N(Count, Severity)    ALOG_SAMPLED_IMPL(ALOGGER, Severity, everyN, Count)
+#define ALOG_MAIN_FIRST_N(Count, Severity)    ALOG_SAMPLED_IMPL(ALOGGER, Severity, firstN, Count)
+#define ALOG_MAIN_EVERY_MS(Ms, Severity)      ALOG_SAMPLED_IMPL(ALOGGER, Severity, everyMs, Ms)
+
+// Compile-time severity stripping
+#ifndef ALOG_MIN_SEVERITY
+#define ALOG_MIN_SEVERITY 0
+#endif
+
+#if ALOG_MIN_SEVERITY < 0 || ALOG_MIN_SEVERITY > 5
+#error "ALOG_MIN_SEVERITY should be in range 0 (Verbose) .. 5 (Fatal)"
+#endif
+
+#define ALOG_STRIPPED                    if (true) {;} else ALog::MockRecord()
+
+#if ALOG_MIN_SEVERITY > 0
+#define ALOG_SEVERITY_GATE_V(...)       ALOG_STRIPPED
+#define ALOG_PREPARE_GATE_Verbose(...)  ALog::I::StrippedStatement()
+#else
+#define ALOG_SEVERITY_GATE_V(...)       __VA_ARGS__
+#define ALOG_PREPARE_GATE_Verbose(...)  __VA_ARGS__
+#endif
+
+#if ALOG_MIN_SEVERITY > 1
+#define ALOG_SEVERITY_GATE_D(...)       ALOG_STRIPPED
+#define ALOG_PREPARE_GATE_Debug(...)    ALog::I::StrippedStatement()
+#else
+#define ALOG_SEVERITY_GATE_D(...)       __VA_ARGS__
+#define ALOG_PREPARE_GATE_Debug(...)    __VA_ARGS__
+#endif
+
+#if ALOG_MIN_SEVERITY > 2
+#define ALOG_SEVERITY_GATE_I(...)       ALOG_STRIPPED
+#define ALOG_PREPARE_GATE_Info(...)     ALog::I::StrippedStatement()
+#else
+#define ALOG_SEVERITY_GATE_I(...)       __VA_ARGS__
+#define ALOG_PREPARE_GATE_Info(...)     __VA_ARGS__
+#endif
+
+#if ALOG_MIN_SEVERITY > 3
+#define ALOG_SEVERITY_GATE_W(...)       ALOG_STRIPPED
+#define ALOG_PREPARE_GATE_Warning(...)  ALog::I::StrippedStatement()
+#else
+#define ALOG_SEVERITY_GATE_W(...)       __VA_ARGS__
+#define ALOG_PREPARE_GATE_Warning(...)  __VA_ARGS__
+#endif
+
+#if ALOG_MIN_SEVERITY > 4
+#define ALOG_SEVERITY_GATE_E(...)       ALOG_STRIPPED
+#define ALOG_PREPARE_GATE_Error(...)    ALog::I::StrippedStatement()
+#else
+#define ALOG_SEVERITY_GATE_E(...)       __VA_ARGS__
+#define ALOG_PREPARE_GATE_Error(...)    __VA_ARGS__
+#endif
+
+#define ALOG_PREPARE_GATE_Fatal(...)    __VA_ARGS__
+#define ALOG_PREPARE_GATE_Minimal(...)  ALOG_PREPARE_GATE_Verbose(__VA_ARGS__)
+#define ALOG_PREPARE_GATE_Maximal(...)  ALOG_PREPARE_GATE_Fatal(__VA_ARGS__)
+
 // Special
 #define ALOG_FL_FLUSH                 ALog::Record::Flags::Flush
 #define ALOG_FL_THROW                 ALog::Record::Flags::ThrowSync
@@ -159,83 +378,169 @@ inline ALog::MockRecord&& operator<< (ALog::MockRecord&& r, const T&) { return s
 #define ALOG_SEPARATOR(separator)     ALog::Record::Separator::create(separator)
 #define ALOG_SEPARATOR_ONCE(separator) ALog::Record::Separator::create(separator, true)
 #define ALOG_SKIP_SEPARATOR(count)    ALog::Record::SkipSeparator::create(count)
-
-#define ALOG_ASSERT(cond)             ALOGF_IF(!(cond)) << ALOG_FL_ABORT << "Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
+#define ALOG_FIELD(name, value)       ALog::Record::Field::create(name, value)
+#define ALOG_LAZY(func)               ALog::Record::Lazy::create(func)
+#define ALOG_HEX(...)                 ALog::Record::Hex::create(__VA_ARGS__)
+#define ALOG_BIN(value)               ALog::Record::Bin::create(value)
+#define ALOG_PTR(ptr)                 ALog::Record::Pointer::create(ptr)
+#define ALOG_SAMPLE_KEY(key)          ALog::Record::SampleKey::create(key)
+
+#define ALOG_PREPARED(stmt, ...)      ALOG_PREPARED_IMPL(ACCESS_ALOGGER_MODULE, stmt, __VA_ARGS__)
+#define ALOGM_PREPARED(stmt, ...)     ALOG_PREPARED_IMPL(ALOGGER, stmt, __VA_ARGS__)
+#define ALOG_AGGREGATE(name, value)   ALOG_AGGREGATE_IMPL(ACCESS_ALOGGER_MODULE, name, value)
+#define ALOGM_AGGREGATE(name, value)  ALOG_AGGREGATE_IMPL(ALOGGER, name, value)
+
+#define ALOG_ASSERT(cond)             ALOG_MODULE_IF(!(cond), ALog::Severity::Fatal) << ALOG_FL_ABORT << "Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
 #ifdef NDEBUG
 #define ALOG_ASSERT_D(cond)           ALog::MockRecord()
 #else
 #define ALOG_ASSERT_D(cond)           ALOG_ASSERT(cond)
 #endif
-#define ALOG_ASSERT_THROW(cond)       ALOGE_IF(!(cond)) << ALOG_FL_THROW << "Exception. Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
+#define ALOG_ASSERT_THROW(cond)       ALOG_MODULE_IF(!(cond), ALog::Severity::Error) << ALOG_FL_THROW << "Exception. Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
 
-#define ALOGM_ASSERT(cond)             ALOGMF_IF(!(cond)) << ALOG_FL_ABORT << "Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
+#define ALOGM_ASSERT(cond)             ALOG_MAIN_IF(!(cond), ALog::Severity::Fatal) << ALOG_FL_ABORT << "Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
 #ifdef NDEBUG
 #define ALOGM_ASSERT_D(cond)           ALog::MockRecord()
 #else
 #define ALOGM_ASSERT_D(cond)           ALOGM_ASSERT(cond)
 #endif
-#define ALOGM_ASSERT_THROW(cond)       ALOGME_IF(!(cond)) << ALOG_FL_THROW << "Exception. Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
+#define ALOGM_ASSERT_THROW(cond)       ALOG_MAIN_IF(!(cond), ALog::Severity::Error) << ALOG_FL_THROW << "Exception. Assertion failed: " << #cond << ALOG_SEPARATOR_ONCE("; ")
 
 // Main macros
-#define ALOGV                         ALOG_MODULE(ALog::Severity::Verbose)
-#define ALOGD                         ALOG_MODULE(ALog::Severity::Debug)
-#define ALOGI                         ALOG_MODULE(ALog::Severity::Info)
-#define ALOGW                         ALOG_MODULE(ALog::Severity::Warning)
-#define ALOGE                         ALOG_MODULE(ALog::Severity::Error)
+#define ALOGV                         ALOG_SEVERITY_GATE_V(ALOG_MODULE(ALog::Severity::Verbose))
+#define ALOGD                         ALOG_SEVERITY_GATE_D(ALOG_MODULE(ALog::Severity::Debug))
+#define ALOGI                         ALOG_SEVERITY_GATE_I(ALOG_MODULE(ALog::Severity::Info))
+#define ALOGW                         ALOG_SEVERITY_GATE_W(ALOG_MODULE(ALog::Severity::Warning))
+#define ALOGE                         ALOG_SEVERITY_GATE_E(ALOG_MODULE(ALog::Severity::Error))
 #define ALOGF                         ALOG_MODULE(ALog::Severity::Fatal)
 
-#define ALOGMV                        ALOG_MAIN(ALog::Severity::Verbose)
-#define ALOGMD                        ALOG_MAIN(ALog::Severity::Debug)
-#define ALOGMI                        ALOG_MAIN(ALog::Severity::Info)
-#define ALOGMW                        ALOG_MAIN(ALog::Severity::Warning)
-#define ALOGME                        ALOG_MAIN(ALog::Severity::Error)
+#define ALOGMV                        ALOG_SEVERITY_GATE_V(ALOG_MAIN(ALog::Severity::Verbose))
+#define ALOGMD                        ALOG_SEVERITY_GATE_D(ALOG_MAIN(ALog::Severity::Debug))
+#define ALOGMI                        ALOG_SEVERITY_GATE_I(ALOG_MAIN(ALog::Severity::Info))
+#define ALOGMW                        ALOG_SEVERITY_GATE_W(ALOG_MAIN(ALog::Severity::Warning))
+#define ALOGME                        ALOG_SEVERITY_GATE_E(ALOG_MAIN(ALog::Severity::Error))
 #define ALOGMF                        ALOG_MAIN(ALog::Severity::Fatal)
 
-#define ALOGV_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Verbose)
-#define ALOGD_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Debug)
-#define ALOGI_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Info)
-#define ALOGW_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Warning)
-#define ALOGE_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Error)
+#define ALOGV_N(N)                    ALOG_SEVERITY_GATE_V(ALOG_MODULE_N(N, ALog::Severity::Verbose))
+#define ALOGD_N(N)                    ALOG_SEVERITY_GATE_D(ALOG_MODULE_N(N, ALog::Severity::Debug))
+#define ALOGI_N(N)                    ALOG_SEVERITY_GATE_I(ALOG_MODULE_N(N, ALog::Severity::Info))
+#define ALOGW_N(N)                    ALOG_SEVERITY_GATE_W(ALOG_MODULE_N(N, ALog::Severity::Warning))
+#define ALOGE_N(N)                    ALOG_SEVERITY_GATE_E(ALOG_MODULE_N(N, ALog::Severity::Error))
 #define ALOGF_N(N)                    ALOG_MODULE_N(N, ALog::Severity::Fatal)
 
-#define ALOGMV_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Verbose)
-#define ALOGMD_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Debug)
-#define ALOGMI_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Info)
-#define ALOGMW_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Warning)
-#define ALOGME_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Error)
+#define ALOGMV_N(N)                   ALOG_SEVERITY_GATE_V(ALOG_MAIN_N(N, ALog::Severity::Verbose))
+#define ALOGMD_N(N)                   ALOG_SEVERITY_GATE_D(ALOG_MAIN_N(N, ALog::Severity::Debug))
+#define ALOGMI_N(N)                   ALOG_SEVERITY_GATE_I(ALOG_MAIN_N(N, ALog::Severity::Info))
+#define ALOGMW_N(N)                   ALOG_SEVERITY_GATE_W(ALOG_MAIN_N(N, ALog::Severity::Warning))
+#define ALOGME_N(N)                   ALOG_SEVERITY_GATE_E(ALOG_MAIN_N(N, ALog::Severity::Error))
 #define ALOGMF_N(N)                   ALOG_MAIN_N(N, ALog::Severity::Fatal)
 
 #define ALOG_TRACE                    ALOGD
 
 // Conditional
-#define ALOGV_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Verbose)
-#define ALOGD_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Debug)
-#define ALOGI_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Info)
-#define ALOGW_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Warning)
-#define ALOGE_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Error)
+#define ALOGV_IF(Cond)                ALOG_SEVERITY_GATE_V(ALOG_MODULE_IF(Cond, ALog::Severity::Verbose))
+#define ALOGD_IF(Cond)                ALOG_SEVERITY_GATE_D(ALOG_MODULE_IF(Cond, ALog::Severity::Debug))
+#define ALOGI_IF(Cond)                ALOG_SEVERITY_GATE_I(ALOG_MODULE_IF(Cond, ALog::Severity::Info))
+#define ALOGW_IF(Cond)                ALOG_SEVERITY_GATE_W(ALOG_MODULE_IF(Cond, ALog::Severity::Warning))
+#define ALOGE_IF(Cond)                ALOG_SEVERITY_GATE_E(ALOG_MODULE_IF(Cond, ALog::Severity::Error))
 #define ALOGF_IF(Cond)                ALOG_MODULE_IF(Cond, ALog::Severity::Fatal)
 
-#define ALOGMV_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Verbose)
-#define ALOGMD_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Debug)
-#define ALOGMI_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Info)
-#define ALOGMW_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Warning)
-#define ALOGME_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Error)
+#define ALOGMV_IF(Cond)               ALOG_SEVERITY_GATE_V(ALOG_MAIN_IF(Cond, ALog::Severity::Verbose))
+#define ALOGMD_IF(Cond)               ALOG_SEVERITY_GATE_D(ALOG_MAIN_IF(Cond, ALog::Severity::Debug))
+#define ALOGMI_IF(Cond)               ALOG_SEVERITY_GATE_I(ALOG_MAIN_IF(Cond, ALog::Severity::Info))
+#define ALOGMW_IF(Cond)               ALOG_SEVERITY_GATE_W(ALOG_MAIN_IF(Cond, ALog::Severity::Warning))
+#define ALOGME_IF(Cond)               ALOG_SEVERITY_GATE_E(ALOG_MAIN_IF(Cond, ALog::Severity::Error))
 #define ALOGMF_IF(Cond)               ALOG_MAIN_IF(Cond, ALog::Severity::Fatal)
 
-#define ALOGV_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Verbose)
-#define ALOGD_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Debug)
-#define ALOGI_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Info)
-#define ALOGW_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Warning)
-#define ALOGE_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Error)
+#define ALOGV_IF_N(N, Cond)           ALOG_SEVERITY_GATE_V(ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Verbose))
+#define ALOGD_IF_N(N, Cond)           ALOG_SEVERITY_GATE_D(ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Debug))
+#define ALOGI_IF_N(N, Cond)           ALOG_SEVERITY_GATE_I(ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Info))
+#define ALOGW_IF_N(N, Cond)           ALOG_SEVERITY_GATE_W(ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Warning))
+#define ALOGE_IF_N(N, Cond)           ALOG_SEVERITY_GATE_E(ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Error))
 #define ALOGF_IF_N(N, Cond)           ALOG_MODULE_IF_N(N, Cond, ALog::Severity::Fatal)
 
-#define ALOGMV_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Verbose)
-#define ALOGMD_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Debug)
-#define ALOGMI_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Info)
-#define ALOGMW_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Warning)
-#define ALOGME_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Error)
+#define ALOGMV_IF_N(N, Cond)          ALOG_SEVERITY_GATE_V(ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Verbose))
+#define ALOGMD_IF_N(N, Cond)          ALOG_SEVERITY_GATE_D(ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Debug))
+#define ALOGMI_IF_N(N, Cond)          ALOG_SEVERITY_GATE_I(ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Info))
+#define ALOGMW_IF_N(N, Cond)          ALOG_SEVERITY_GATE_W(ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Warning))
+#define ALOGME_IF_N(N, Cond)          ALOG_SEVERITY_GATE_E(ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Error))
 #define ALOGMF_IF_N(N, Cond)          ALOG_MAIN_IF_N(N, Cond, ALog::Severity::Fatal)
 
+// Sampling (per call-site)
+#define ALOGV_EVERY_N(Count)          ALOG_SEVERITY_GATE_V(ALOG_MODULE_EVERY_N(Count, ALog::Severity::Verbose))
+#define ALOGD_EVERY_N(Count)          ALOG_SEVERITY_GATE_D(ALOG_MODULE_EVERY_N(Count, ALog::Severity::Debug))
+#define ALOGI_EVERY_N(Count)          ALOG_SEVERITY_GATE_I(ALOG_MODULE_EVERY_N(Count, ALog::Severity::Info))
+#define ALOGW_EVERY_N(Count)          ALOG_SEVERITY_GATE_W(ALOG_MODULE_EVERY_N(Count, ALog::Severity::Warning))
+#define ALOGE_EVERY_N(Count)          ALOG_SEVERITY_GATE_E(ALOG_MODULE_EVERY_N(Count, ALog::Severity::Error))
+#define ALOGF_EVERY_N(Count)          ALOG_MODULE_EVERY_N(Count, ALog::Severity::Fatal)
+
+#define ALOGMV_EVERY_N(Count)         ALOG_SEVERITY_GATE_V(ALOG_MAIN_EVERY_N(Count, ALog::Severity::Verbose))
+#define ALOGMD_EVERY_N(Count)         ALOG_SEVERITY_GATE_D(ALOG_MAIN_EVERY_N(Count, ALog::Severity::Debug))
+#define ALOGMI_EVERY_N(Count)         ALOG_SEVERITY_GATE_I(ALOG_MAIN_EVERY_N(Count, ALog::Severity::Info))
+#define ALOGMW_EVERY_N(Count)         ALOG_SEVERITY_GATE_W(ALOG_MAIN_EVERY_N(Count, ALog::Severity::Warning))
+#define ALOGME_EVERY_N(Count)         ALOG_SEVERITY_GATE_E(ALOG_MAIN_EVERY_N(Count, ALog::Severity::Error))
+#define ALOGMF_EVERY_N(Count)         ALOG_MAIN_EVERY_N(Count, ALog::Severity::Fatal)
+
+#define ALOGV_FIRST_N(Count)          ALOG_SEVERITY_GATE_V(ALOG_MODULE_FIRST_N(Count, ALog::Severity::Verbose))
+#define ALOGD_FIRST_N(Count)          ALOG_SEVERITY_GATE_D(ALOG_MODULE_FIRST_N(Count, ALog::Severity::Debug))
+#define ALOGI_FIRST_N(Count)          ALOG_SEVERITY_GATE_I(ALOG_MODULE_FIRST_N(Count, ALog::Severity::Info))
+#define ALOGW_FIRST_N(Count)          ALOG_SEVERITY_GATE_W(ALOG_MODULE_FIRST_N(Count, ALog::Severity::Warning))
+#define ALOGE_FIRST_N(Count)          ALOG_SEVERITY_GATE_E(ALOG_MODULE_FIRST_N(Count, ALog::Severity::Error))
+#define ALOGF_FIRST_N(Count)          ALOG_MODULE_FIRST_N(Count, ALog::Severity::Fatal)
+
+#define ALOGMV_FIRST_N(Count)         ALOG_SEVERITY_GATE_V(ALOG_MAIN_FIRST_N(Count, ALog::Severity::Verbose))
+#define ALOGMD_FIRST_N(Count)         ALOG_SEVERITY_GATE_D(ALOG_MAIN_FIRST_N(Count, ALog::Severity::Debug))
+#define ALOGMI_FIRST_N(Count)         ALOG_SEVERITY_GATE_I(ALOG_MAIN_FIRST_N(Count, ALog::Severity::Info))
+#define ALOGMW_FIRST_N(Count)         ALOG_SEVERITY_GATE_W(ALOG_MAIN_FIRST_N(Count, ALog::Severity::Warning))
+#define ALOGME_FIRST_N(Count)         ALOG_SEVERITY_GATE_E(ALOG_MAIN_FIRST_N(Count, ALog::Severity::Error))
+#define ALOGMF_FIRST_N(Count)         ALOG_MAIN_FIRST_N(Count, ALog::Severity::Fatal)
+
+#define ALOGV_EVERY_MS(Ms)            ALOG_SEVERITY_GATE_V(ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Verbose))
+#define ALOGD_EVERY_MS(Ms)            ALOG_SEVERITY_GATE_D(ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Debug))
+#define ALOGI_EVERY_MS(Ms)            ALOG_SEVERITY_GATE_I(ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Info))
+#define ALOGW_EVERY_MS(Ms)            ALOG_SEVERITY_GATE_W(ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Warning))
+#define ALOGE_EVERY_MS(Ms)            ALOG_SEVERITY_GATE_E(ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Error))
+#define ALOGF_EVERY_MS(Ms)            ALOG_MODULE_EVERY_MS(Ms, ALog::Severity::Fatal)
+
+#define ALOGMV_EVERY_MS(Ms)           ALOG_SEVERITY_GATE_V(ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Verbose))
+#define ALOGMD_EVERY_MS(Ms)           ALOG_SEVERITY_GATE_D(ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Debug))
+#define ALOGMI_EVERY_MS(Ms)           ALOG_SEVERITY_GATE_I(ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Info))
+#define ALOGMW_EVERY_MS(Ms)           ALOG_SEVERITY_GATE_W(ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Warning))
+#define ALOGME_EVERY_MS(Ms)           ALOG_SEVERITY_GATE_E(ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Error))
+#define ALOGMF_EVERY_MS(Ms)           ALOG_MAIN_EVERY_MS(Ms, ALog::Severity::Fatal)
+
+// Signal-safe
+#define ALOGV_SIGNAL                  ALOG_SEVERITY_GATE_V(ALOG_MODULE_SIGNAL(ALog::Severity::Verbose))
+#define ALOGD_SIGNAL                  ALOG_SEVERITY_GATE_D(ALOG_MODULE_SIGNAL(ALog::Severity::Debug))
+#define ALOGI_SIGNAL                  ALOG_SEVERITY_GATE_I(ALOG_MODULE_SIGNAL(ALog::Severity::Info))
+#define ALOGW_SIGNAL                  ALOG_SEVERITY_GATE_W(ALOG_MODULE_SIGNAL(ALog::Severity::Warning))
+#define ALOGE_SIGNAL                  ALOG_SEVERITY_GATE_E(ALOG_MODULE_SIGNAL(ALog::Severity::Error))
+#define ALOGF_SIGNAL                  ALOG_MODULE_SIGNAL(ALog::Severity::Fatal)
+
+#define ALOGMV_SIGNAL                 ALOG_SEVERITY_GATE_V(ALOG_MAIN_SIGNAL(ALog::Severity::Verbose))
+#define ALOGMD_SIGNAL                 ALOG_SEVERITY_GATE_D(ALOG_MAIN_SIGNAL(ALog::Severity::Debug))
+#define ALOGMI_SIGNAL                 ALOG_SEVERITY_GATE_I(ALOG_MAIN_SIGNAL(ALog::Severity::Info))
+#define ALOGMW_SIGNAL                 ALOG_SEVERITY_GATE_W(ALOG_MAIN_SIGNAL(ALog::Severity::Warning))
+#define ALOGME_SIGNAL                 ALOG_SEVERITY_GATE_E(ALOG_MAIN_SIGNAL(ALog::Severity::Error))
+#define ALOGMF_SIGNAL                 ALOG_MAIN_SIGNAL(ALog::Severity::Fatal)
+
+#ifdef ALOG_HAS_STD_FORMAT
+// std::format-style (C++20)
+#define ALOGV_FMT(...)                ALOGV << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGD_FMT(...)                ALOGD << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGI_FMT(...)                ALOGI << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGW_FMT(...)                ALOGW << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGE_FMT(...)                ALOGE << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGF_FMT(...)                ALOGF << ALog::I::makeFormat(__VA_ARGS__)
+
+#define ALOGMV_FMT(...)               ALOGMV << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGMD_FMT(...)               ALOGMD << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGMI_FMT(...)               ALOGMI << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGMW_FMT(...)               ALOGMW << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGME_FMT(...)               ALOGME << ALog::I::makeFormat(__VA_ARGS__)
+#define ALOGMF_FMT(...)               ALOGMF << ALog::I::makeFormat(__VA_ARGS__)
+#endif // ALOG_HAS_STD_FORMAT
+
 
 // --- Short ---
 #ifndef ALOG_NO_SHORT_MACROS
@@ -256,7 +561,17 @@ inline ALog::MockRecord&& operator<< (ALog::MockRecord&& r, const T&) { return s
 #define SEP(separator)             ALOG_SEPARATOR(separator)
 #define OSEP(separator)            ALOG_SEPARATOR_ONCE(separator)
 #define SSEP(count)                ALOG_SKIP_SEPARATOR(count)
-
+#define FIELD(name, value)         ALOG_FIELD(name, value)
+#define LAZY(func)                 ALOG_LAZY(func)
+#define HEX(...)                   ALOG_HEX(__VA_ARGS__)
+#define BIN(value)                 ALOG_BIN(value)
+#define PTR(ptr)                   ALOG_PTR(ptr)
+#define SAMPLE_KEY(key)            ALOG_SAMPLE_KEY(key)
+
+#define LOG_PREPARED(stmt, ...)     ALOG_PREPARED(stmt, __VA_ARGS__)
+#define LOGM_PREPARED(stmt, ...)    ALOGM_PREPARED(stmt, __VA_ARGS__)
+#define LOG_AGGREGATE(name, value)  ALOG_AGGREGATE(name, value)
+#define LOGM_AGGREGATE(name, value) ALOGM_AGGREGATE(name, value)
 #define LOG_ASSERT(cond)           ALOG_ASSERT(cond)
 #define LOG_ASSERT_D(cond)         ALOG_ASSERT_D(cond)
 #define LOG_ASSERT_THROW(cond)     ALOG_ASSERT_THROW(cond)
@@ -324,4 +639,79 @@ inline ALog::MockRecord&& operator<< (ALog::MockRecord&& r, const T&) { return s
 #define LOGMW_IF_N(N, Cond)        ALOGMW_IF_N(N, Cond)
 #define LOGME_IF_N(N, Cond)        ALOGME_IF_N(N, Cond)
 #define LOGMF_IF_N(N, Cond)        ALOGMF_IF_N(N, Cond)
+
+// Short sampling
+#define LOGV_EVERY_N(Count)        ALOGV_EVERY_N(Count)
+#define LOGD_EVERY_N(Count)        ALOGD_EVERY_N(Count)
+#define LOGI_EVERY_N(Count)        ALOGI_EVERY_N(Count)
+#define LOGW_EVERY_N(Count)        ALOGW_EVERY_N(Count)
+#define LOGE_EVERY_N(Count)        ALOGE_EVERY_N(Count)
+#define LOGF_EVERY_N(Count)        ALOGF_EVERY_N(Count)
+
+#define LOGMV_EVERY_N(Count)       ALOGMV_EVERY_N(Count)
+#define LOGMD_EVERY_N(Count)       ALOGMD_EVERY_N(Count)
+#define LOGMI_EVERY_N(Count)       ALOGMI_EVERY_N(Count)
+#define LOGMW_EVERY_N(Count)       ALOGMW_EVERY_N(Count)
+#define LOGME_EVERY_N(Count)       ALOGME_EVERY_N(Count)
+#define LOGMF_EVERY_N(Count)       ALOGMF_EVERY_N(Count)
+
+#define LOGV_FIRST_N(Count)        ALOGV_FIRST_N(Count)
+#define LOGD_FIRST_N(Count)        ALOGD_FIRST_N(Count)
+#define LOGI_FIRST_N(Count)        ALOGI_FIRST_N(Count)
+#define LOGW_FIRST_N(Count)        ALOGW_FIRST_N(Count)
+#define LOGE_FIRST_N(Count)        ALOGE_FIRST_N(Count)
+#define LOGF_FIRST_N(Count)        ALOGF_FIRST_N(Count)
+
+#define LOGMV_FIRST_N(Count)       ALOGMV_FIRST_N(Count)
+#define LOGMD_FIRST_N(Count)       ALOGMD_FIRST_N(Count)
+#define LOGMI_FIRST_N(Count)       ALOGMI_FIRST_N(Count)
+#define LOGMW_FIRST_N(Count)       ALOGMW_FIRST_N(Count)
+#define LOGME_FIRST_N(Count)       ALOGME_FIRST_N(Count)
+#define LOGMF_FIRST_N(Count)       ALOGMF_FIRST_N(Count)
+
+#define LOGV_EVERY_MS(Ms)          ALOGV_EVERY_MS(Ms)
+#define LOGD_EVERY_MS(Ms)          ALOGD_EVERY_MS(Ms)
+#define LOGI_EVERY_MS(Ms)          ALOGI_EVERY_MS(Ms)
+#define LOGW_EVERY_MS(Ms)          ALOGW_EVERY_MS(Ms)
+#define LOGE_EVERY_MS(Ms)          ALOGE_EVERY_MS(Ms)
+#define LOGF_EVERY_MS(Ms)          ALOGF_EVERY_MS(Ms)
+
+#define LOGMV_EVERY_MS(Ms)         ALOGMV_EVERY_MS(Ms)
+#define LOGMD_EVERY_MS(Ms)         ALOGMD_EVERY_MS(Ms)
+#define LOGMI_EVERY_MS(Ms)         ALOGMI_EVERY_MS(Ms)
+#define LOGMW_EVERY_MS(Ms)         ALOGMW_EVERY_MS(Ms)
+#define LOGME_EVERY_MS(Ms)         ALOGME_EVERY_MS(Ms)
+#define LOGMF_EVERY_MS(Ms)         ALOGMF_EVERY_MS(Ms)
+
+// Short signal-safe
+#define LOGV_SIGNAL                ALOGV_SIGNAL
+#define LOGD_SIGNAL                ALOGD_SIGNAL
+#define LOGI_SIGNAL                ALOGI_SIGNAL
+#define LOGW_SIGNAL                ALOGW_SIGNAL
+#define LOGE_SIGNAL                ALOGE_SIGNAL
+#define LOGF_SIGNAL                ALOGF_SIGNAL
+
+#define LOGMV_SIGNAL               ALOGMV_SIGNAL
+#define LOGMD_SIGNAL               ALOGMD_SIGNAL
+#define LOGMI_SIGNAL               ALOGMI_SIGNAL
+#define LOGMW_SIGNAL               ALOGMW_SIGNAL
+#define LOGME_SIGNAL               ALOGME_SIGNAL
+#define LOGMF_SIGNAL               ALOGMF_SIGNAL
+
+#ifdef ALOG_HAS_STD_FORMAT
+// Short std::format-style
+#define LOGV_FMT(...)              ALOGV_FMT(__VA_ARGS__)
+#define LOGD_FMT(...)              ALOGD_FMT(__VA_ARGS__)
+#define LOGI_FMT(...)              ALOGI_FMT(__VA_ARGS__)
+#define LOGW_FMT(...)              ALOGW_FMT(__VA_ARGS__)
+#define LOGE_FMT(...)              ALOGE_FMT(__VA_ARGS__)
+#define LOGF_FMT(...)              ALOGF_FMT(__VA_ARGS__)
+
+#define LOGMV_FMT(...)             ALOGMV_FMT(__VA_ARGS__)
+#define LOGMD_FMT(...)             ALOGMD_FMT(__VA_ARGS__)
+#define LOGMI_FMT(...)             ALOGMI_FMT(__VA_ARGS__)
+#define LOGMW_FMT(...)             ALOGMW_FMT(__VA_ARGS__)
+#define LOGME_FMT(...)             ALOGME_FMT(__VA_ARGS__)
+#define LOGMF_FMT(...)             ALOGMF_FMT(__VA_ARGS__)
+#endif // ALOG_HAS_STD_FORMAT
 #endif // #ifndef ALOG_NO_SHORT_MACROS
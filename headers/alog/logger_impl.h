@@ -4,12 +4,15 @@
 
 #pragma once
 #include <alog/record.h>
+#include <alog/batch.h>
 #include <alog/tools.h>
 #include <alog/sinks/pipeline.h>
 
 
 namespace ALog {
 
+struct SignalRecord;
+
 void alog_breakpoint();
 [[noreturn]] void alog_abort();
 [[noreturn]] void alog_exception(const char* msg);
@@ -34,19 +37,66 @@ public:
     // Thread-safe
     void addRecord(Record&& Record);
     void operator+= (Record&& record) { addRecord(std::move(record)); }
+    void addRecords(Batch&& batch);
+    void operator+= (Batch&& batch) { addRecords(std::move(batch)); }
+
+    // Async-signal-safe. Returns false if signal slots are disabled or all busy (see setSignalSlots)
+    bool addSignalRecord(const SignalRecord& record) noexcept;
+    void operator+= (const SignalRecord& record) noexcept { addSignalRecord(record); }
     void flush();
     void setAutoflush(bool value = true);
 
     // Not thread-safe
     void setMode(LoggerMode mode);
 
+    // Keep last 'capacity' records rejected by filters in memory. They are written (unfiltered, marked with
+    // Record::Flags::Backtrace) ahead of next passed record with severity >= 'trigger'. 0 - disable. Not thread-safe.
+    void setBacktrace(size_t capacity, Severity trigger = Severity::Error);
+
+    // Preallocate 'count' slots for records from signal handlers (ALOGx_SIGNAL macros). 0 - disable.
+    // Slots are drained every 10 ms in asynchronous modes, on next record or flush in synchronous mode.
+    // Not thread-safe, should be called before installing signal handlers.
+    void setSignalSlots(size_t count);
+    uint64_t droppedSignalRecords() const;
+
+    // Emit summary of each ALOG_AGGREGATE site (one record per site with samples) every 'interval'. 0 - disable.
+    // Statistics are process-wide, so aggregation should be enabled in one logger only. Not thread-safe.
+    void setAggregation(std::chrono::milliseconds interval, Severity severity = Severity::Info);
+
+    // Thread-safe. Emit summaries of ALOG_AGGREGATE sites now
+    void emitAggregates();
+
+    // Evaluate pipeline filters in producer threads, so rejected records aren't queued and sorted.
+    // Verdicts of filters, which depend on severity, module and file only, are cached by call-sites of logging macros
+    // until configuration changes. Filters should be thread-safe. Ignored while backtrace is enabled. Not thread-safe.
+    void setProducerFiltering(bool value = true);
+
+#ifdef ALOG_HAS_PMR
+    // Memory resource for queue and backtrace ring. nullptr - ALog::memoryResource() at the moment of call.
+    // Not thread-safe, queued records are written before switching.
+    void setMemoryResource(std::pmr::memory_resource* resource);
+#endif // ALOG_HAS_PMR
+
+    // Direct changes aren't thread-safe, use reconfigure() while logging
     ALog::Sinks::Pipeline& pipeline();
     const ALog::Sinks::Pipeline& pipeline() const;
 
+    // Thread-safe. Atomically replaces pipeline with content of 'pipeline', which receives the flushed previous one.
+    // Queued records aren't lost, they are written by new pipeline.
+    void reconfigure(ALog::Sinks::Pipeline& pipeline);
+
 private:
     void startThread();
     void stopThread();
     void threadFunc();
+    void writeRecord(Record& record);
+    bool prepareRecord(Record& record);
+    bool canPassInProducer(const Record& record);
+    bool siteVerdictsAllowed(uint32_t epoch);
+    template<typename Func>
+    void drainSignalRecords(const Func& func);
+    template<typename Func>
+    void emitAggregatesIfDue(const Func& func);
 
 private:
     ALOG_DECLARE_PIMPL
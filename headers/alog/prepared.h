@@ -0,0 +1,164 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <alog/record.h>
+#include <alog/severity.h>
+
+namespace ALog {
+
+// Argument slot of prepared statement (see ALOG_PREPARE)
+struct Placeholder { };
+
+namespace Placeholders {
+inline constexpr Placeholder _ {};
+} // namespace Placeholders
+
+namespace Internal {
+template<typename... Fragments>
+inline constexpr size_t placeholdersCount = ((std::is_same_v<Fragments, Placeholder> ? 1 : 0) + ... + 0);
+
+// Fragments which only append text. Others (flags, separators, fields, ...) change record state, which isn't rendered
+template<typename T>
+inline constexpr bool isPreparedFragment = std::is_same_v<T, Placeholder> || std::is_arithmetic_v<T> ||
+                                           std::is_convertible_v<const T&, std::string_view>;
+} // namespace Internal
+
+// Logging statement with constant fragments rendered once. Each call appends pre-rendered text of fragments
+// (with separators and quotes applied) and regular renders of arguments only. Fragments are text or numbers.
+//   static const auto stmt = ALOG_PREPARE(Info, "Order", _, "filled at", _);
+//   LOG_PREPARED(stmt, orderId, price);
+template<size_t ArgsCount>
+class PreparedStatement
+{
+public:
+    // Statement bound to call-site (see LOG_PREPARED)
+    class Call
+    {
+    public:
+        Call(const PreparedStatement& statement, int line, const char* file, const char* fileOnly, const char* func)
+            : m_statement(statement), m_line(line), m_file(file), m_fileOnly(fileOnly), m_func(func) { }
+
+        template<typename... Args>
+        [[nodiscard]] Record record(const Args&... args) const {
+            static_assert(sizeof...(Args) == ArgsCount, "Wrong arguments count for prepared statement");
+
+            auto result = Record::create(m_statement.m_severity, m_line, m_file, m_fileOnly, m_func);
+            appendRun(result, m_statement.m_runs[0]);
+
+            size_t run = 1;
+            (((void)(std::move(result) << args), appendRun(result, m_statement.m_runs[run++])), ...);
+            (void)run;
+
+            return result;
+        }
+
+    private:
+        const PreparedStatement& m_statement;
+        int m_line;
+        const char* m_file;
+        const char* m_fileOnly;
+        const char* m_func;
+    };
+
+    template<typename... Fragments>
+    [[nodiscard]] static PreparedStatement create(Severity severity, const Fragments&... fragments) {
+        static_assert(Internal::placeholdersCount<Fragments...> == ArgsCount, "Wrong placeholders count");
+        static_assert((Internal::isPreparedFragment<Fragments> && ...),
+                      "ALOG_PREPARE: fragments should be text or numbers, flags and manipulators aren't kept");
+
+        PreparedStatement result;
+        result.m_severity = severity;
+
+        size_t run = 0;
+        (result.addFragment(run, fragments), ...);
+        return result;
+    }
+
+    Severity severity() const { return m_severity; }
+
+    [[nodiscard]] Call at(int line, const char* file, const char* fileOnly, const char* func) const {
+        return Call(*this, line, file, fileOnly, func);
+    }
+
+private:
+    struct Run {
+        std::string first; // Text if message is empty
+        std::string next;  // Text if message isn't empty, i.e. with leading separator
+        bool hasFragments {};
+    };
+
+    PreparedStatement() = default;
+
+    template<typename T>
+    void addFragment(size_t& run, const T& fragment) {
+        if constexpr (std::is_same_v<T, Placeholder>) {
+            run++;
+        } else {
+            // Rendered by regular operators, on top of previous fragments of same run
+            auto& target = m_runs[run];
+            target.first = render(target.hasFragments ? target.first : std::string(), fragment, false);
+            target.next = render(target.hasFragments ? target.next : std::string(), fragment, !target.hasFragments);
+            target.hasFragments = true;
+        }
+    }
+
+    template<typename T>
+    std::string render(const std::string& prefix, const T& fragment, bool afterText) const {
+        auto record = Record::create(m_severity, 0, "", "", "");
+
+        // Non-empty message makes separator to be inserted; placeholder symbol is cut off then
+        const size_t skip = afterText ? 1 : 0;
+        if (afterText) record.message.appendString("x", 1);
+        record.message.appendString(prefix.data(), prefix.size());
+
+        (void)(std::move(record) << fragment);
+        return std::string(record.getMessage() + skip, record.getMessageLen() - skip);
+    }
+
+    static void appendRun(Record& record, const Run& run) {
+        const auto& text = record.message ? run.next : run.first;
+        record.message.appendString(text.data(), text.size());
+    }
+
+private:
+    Severity m_severity {};
+    std::array<Run, ArgsCount + 1> m_runs;
+};
+
+namespace Internal {
+
+// Fragments are passed separately, where placeholder name is visible
+struct Preparer
+{
+    Severity severity;
+
+    template<typename... Fragments>
+    [[nodiscard]] auto operator()(const Fragments&... fragments) const {
+        return PreparedStatement<placeholdersCount<Fragments...>>::create(severity, fragments...);
+    }
+};
+
+// Result of ALOG_PREPARE below ALOG_MIN_SEVERITY. Its LOG_PREPARED statements are discarded at compile time
+struct StrippedStatement
+{
+    struct Call {
+        template<typename... Args>
+        [[nodiscard]] Record record(const Args&...) const { return {}; }
+    };
+
+    Severity severity() const { return Severity::Minimal; }
+
+    [[nodiscard]] Call at(int, const char*, const char*, const char*) const { return {}; }
+};
+
+template<typename T>
+inline constexpr bool isStrippedStatement = std::is_same_v<std::decay_t<T>, StrippedStatement>;
+
+} // namespace Internal
+} // namespace ALog
@@ -14,13 +14,25 @@
 #include <optional>
 #include <type_traits>
 #include <variant>
+#include <string_view>
+#include <ostream>
 #include <alog/severity.h>
 #include <alog/tools.h>
+#include <alog/enums.h>
 
 #ifdef ALOG_CXX23
 #include <expected>
 #endif // ALOG_CXX23
 
+#if defined(ALOG_CXX20) && __has_include(<format>)
+#include <format>
+#include <iterator>
+#include <tuple>
+#if defined(__cpp_lib_format)
+#define ALOG_HAS_STD_FORMAT
+#endif // __cpp_lib_format
+#endif // ALOG_CXX20
+
 #include <jeaiii_to_text.h>
 
 #ifdef ALOG_HAS_QT_LIBRARY
@@ -30,10 +42,13 @@
 namespace ALog {
 struct Record;
 namespace Internal {
+class Site;
 template<typename Iter>
 void logArray(Record& record, size_t sz, Iter begin, Iter end);
 template<typename SmartPtrType>
 void logSmartPtr(Record& record, const SmartPtrType& value, const char* smartPtrName);
+template<typename Func>
+void invokeLazy(const void* func, Record& record);
 } // namespace Internal
 } // namespace ALog
 
@@ -45,6 +60,7 @@ struct Record
     friend inline void onStringQuote1(Record& record, bool literal);
     friend inline void onStringQuote2(Record& record);
     static constexpr size_t separator_sso_len = 8;
+    static constexpr size_t fields_sso_len = 47;
 
     // Deprecated: "See inline Record(uninitialized_tag)"
     struct uninitialized_tag {};
@@ -65,11 +81,14 @@ struct Record
         NoAutoQuote = 256,           // 256
         QuoteLiterals = 512,         // 512
 
+        Backtrace = 32768,           // Record was held in backtrace ring (see Logger::setBacktrace)
+
         Internal_NoSeparators    = 1024,
         Internal_QuoteClose      = 2048,
         Internal_Queued          = 4096,
         Internal_QuoteLiterals   = 8192,
         Internal_RestoreSepBckp = 16384,
+        Internal_Filtered        = 65536, // Passed filters in producer thread
     };
 
     struct RawData {
@@ -78,6 +97,38 @@ struct Record
         size_t sz;
     };
 
+    // Integer manipulators (see ALOG_HEX, ALOG_BIN, ALOG_PTR)
+    struct Hex {
+        template<typename T>
+        [[nodiscard]] static inline Hex create(T value, size_t width = 0) {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "ALOG_HEX: integer expected");
+            Hex r; r.value = static_cast<std::make_unsigned_t<T>>(value); r.width = width; return r;
+        };
+        uint64_t value;
+        size_t width;
+    };
+
+    struct Bin {
+        template<typename T>
+        [[nodiscard]] static inline Bin create(T value) {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "ALOG_BIN: integer expected");
+            Bin r; r.value = static_cast<std::make_unsigned_t<T>>(value); r.bits = sizeof(T) * 8; return r;
+        };
+        uint64_t value;
+        size_t bits;
+    };
+
+    struct Pointer {
+        [[nodiscard]] static inline Pointer create(const void* ptr) { Pointer r; r.ptr = ptr; return r; };
+        const void* ptr;
+    };
+
+    // Caller-supplied ID for consistent sampling (see Filters::HashSample)
+    struct SampleKey {
+        [[nodiscard]] static inline SampleKey create(uint64_t key) { SampleKey r; r.key = key; return r; };
+        uint64_t key;
+    };
+
     struct Separator {
         [[nodiscard]] static inline Separator create() { Separator r; return r; };
         [[nodiscard]] static inline Separator create(const char* separator, bool once = false) { Separator r; r.separator.appendStringAL(separator); r.once = once; return r; };
@@ -94,6 +145,91 @@ struct Record
         int count {};
     };
 
+    // Typed key/value, stored in binary form (see ALOG_FIELD)
+    struct Field {
+        enum class Type : uint8_t { Integer, Unsigned, Double, Bool, String };
+
+        template<typename T>
+        [[nodiscard]] static inline Field create(const char* name, const T& value) {
+            Field r;
+            r.name = name;
+
+            if constexpr (std::is_same_v<T, bool>) {
+                r.type = Type::Bool;
+                r.value.b = value;
+            } else if constexpr (std::is_enum_v<T>) {
+                return create(name, static_cast<std::underlying_type_t<T>>(value));
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                r.type = Type::Integer;
+                r.value.i = value;
+            } else if constexpr (std::is_integral_v<T>) {
+                r.type = Type::Unsigned;
+                r.value.u = value;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                r.type = Type::Double;
+                r.value.d = static_cast<double>(value);
+            } else if constexpr (std::is_convertible_v<const T&, const char*>) {
+                const char* str = value;
+                r.type = Type::String;
+                r.str = str ? str : "";
+                r.strLen = str ? strlen(str) : 0;
+            } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                const std::string_view str = value;
+                r.type = Type::String;
+                r.str = str.data();
+                r.strLen = str.size();
+            } else {
+                static_assert(!sizeof(T*), "Unsupported field type");
+            }
+
+            return r;
+        };
+
+        // Appends value in JSON-compatible form (strings are quoted and escaped, non-finite doubles are 'null')
+        void appendValue(I::LongSSO<>& out) const;
+
+        const char* name {};  // Literal ptr
+        Type type {};
+        union { int64_t i; uint64_t u; double d; bool b; } value {};
+        const char* str {};   // Not null-terminated
+        size_t strLen {};
+    };
+
+    // Entry of thread-local diagnostic context (see ALog::ScopedContext). Immutable once published.
+    struct Context {
+        Field value;         // value.name is the key
+        std::string storage; // Owns string value
+        std::shared_ptr<const Context> parent;
+    };
+
+    // Deferred argument (see ALOG_LAZY). Refers to callable temporary and should not outlive logging statement.
+    struct Lazy {
+        template<typename Func>
+        [[nodiscard]] static inline Lazy create(const Func& func) {
+            Lazy r;
+            r.func = &func;
+            r.invoke = &I::invokeLazy<Func>;
+            return r;
+        };
+
+        const void* func {};
+        void (*invoke)(const void* func, Record& record) {};
+
+        // Filled by Record
+        mutable size_t offset {};
+        mutable int flags {};
+        mutable const Lazy* next {};
+    };
+
+#ifdef ALOG_HAS_STD_FORMAT
+    // Format string with arguments (see ALOGx_FMT). Refers to arguments and should not outlive logging statement.
+    template<typename... Args>
+    struct Format {
+        std::format_string<const Args&...> fmt;
+        std::tuple<const Args&...> args;
+    };
+#endif // ALOG_HAS_STD_FORMAT
+
     // -----
 
     [[nodiscard]] static Record create(Severity severity, int line, const char* file, const char* fileOnly, const char* func);
@@ -117,6 +253,104 @@ struct Record
         appendMessage(str, end - str, width, padding);
     }
 
+    // "0x" + hex digits, zero-padded to 'width' digits
+    inline void appendHex(uint64_t value, size_t width = 0)
+    {
+        char str[2 + 16];
+        char* const end = str + sizeof(str);
+        char* begin = I::toHexReversed(end, value, width);
+        *--begin = 'x';
+        *--begin = '0';
+        appendMessage(begin, end - begin);
+    }
+
+    // "0b" + 'bits' binary digits
+    inline void appendBin(uint64_t value, size_t bits)
+    {
+        char str[2 + 64];
+        str[0] = '0';
+        str[1] = 'b';
+        char* const end = I::toBin(str + 2, value, bits);
+        appendMessage(str, end - str);
+    }
+
+    inline void appendPointer(const void* ptr) { appendHex(reinterpret_cast<uintptr_t>(ptr)); }
+
+    inline void appendField(const Field& field) {
+        const size_t payloadSz = (field.type == Field::Type::String) ? sizeof(uint32_t) + field.strLen : sizeof(field.value);
+        auto target = fields.allocate_copy(sizeof(field.name) + 1 + payloadSz);
+        memcpy(target, &field.name, sizeof(field.name));
+        target += sizeof(field.name);
+        *target++ = static_cast<uint8_t>(field.type);
+
+        if (field.type == Field::Type::String) {
+            const auto len = static_cast<uint32_t>(field.strLen);
+            memcpy(target, &len, sizeof(len));
+            memcpy(target + sizeof(len), field.str, field.strLen);
+        } else {
+            memcpy(target, &field.value, sizeof(field.value));
+        }
+    }
+
+    inline void appendLazy(const Lazy& lazy) {
+        appendMessage("", 0); // Separator goes before deferred value
+        lazy.offset = message.getStringLen();
+        lazy.flags = flags;
+        lazy.next = lazyArgs;
+        lazyArgs = &lazy;
+    }
+
+    inline bool hasLazyArgs() const { return lazyArgs; }
+
+    // Invokes deferred arguments and inserts their text. Called by Logger before record leaves the statement.
+    void resolveLazyArgs();
+
+    inline bool hasFields() const { return fields.getStringLen() != 0; }
+
+    // Field::str points to record's storage and is valid while record is alive and unchanged
+    template<typename Func>
+    inline void forEachField(Func&& func) const {
+        auto it = reinterpret_cast<const uint8_t*>(fields.getString());
+        const auto end = it + fields.getStringLen();
+
+        while (it != end) {
+            Field field;
+            memcpy(&field.name, it, sizeof(field.name));
+            it += sizeof(field.name);
+            field.type = static_cast<Field::Type>(*it++);
+
+            if (field.type == Field::Type::String) {
+                uint32_t len;
+                memcpy(&len, it, sizeof(len));
+                field.str = reinterpret_cast<const char*>(it + sizeof(len));
+                field.strLen = len;
+                it += sizeof(len) + len;
+            } else {
+                memcpy(&field.value, it, sizeof(field.value));
+                it += sizeof(field.value);
+            }
+
+            func(static_cast<const Field&>(field));
+        }
+    }
+
+    // Returns last field with given name
+    inline std::optional<Field> findField(const char* name) const {
+        std::optional<Field> result;
+        forEachField([&result, name](const Field& field){
+            if (field.name == name || !strcmp(field.name, name))
+                result = field;
+        });
+        return result;
+    }
+
+    // From outermost to innermost entry
+    template<typename Func>
+    inline void forEachContext(Func&& func) const { forEachContextImpl(context.get(), func); }
+
+    // Severity threshold check, which honors thread verbosity override
+    inline bool reachesSeverity(Severity threshold) const { return severity >= threshold || (verbosity && severity >= *verbosity); }
+
     inline const char* getMessage() const { return message.getString(); }
     inline size_t getMessageLen() const { return message.getStringLen(); }
 
@@ -157,6 +391,7 @@ struct Record
     Record&& no_seps() { flagsOn(Flags::NoSeparators); return std::move(*this); }
     Record&& quotes() { flagsOn(Flags::AutoQuote); return std::move(*this); }
     Record&& no_quotes() { flagsOn(Flags::NoAutoQuote); return std::move(*this); }
+    Record&& set_suppressed(uint64_t value) { suppressed = value; return std::move(*this); }
 
     Severity severity {};
     int line {};
@@ -166,6 +401,13 @@ struct Record
     int threadNum {};
     const char* threadTitle {}; // Literal ptr
     const char* module {};      // Literal ptr
+    uint16_t moduleId {};       // Interned 'module', 0 if unknown (see I::internModule)
+    uint16_t fileId {};         // Interned 'filenameOnly', 0 if unknown (see I::internFile)
+    I::Site* site {};           // Call-site of logging macro, if any
+    uint64_t suppressed {};     // Occurrences skipped by sampling macros before this record
+    std::shared_ptr<const Context> context; // Diagnostic context of creating thread
+    std::optional<Severity> verbosity;      // Verbosity override of creating thread (see ALog::ScopedVerbosity)
+    std::optional<uint64_t> sampleKey;      // See ALOG_SAMPLE_KEY
 
     std::chrono::time_point<std::chrono::steady_clock> startTp;
     std::chrono::time_point<std::chrono::steady_clock> steadyTp;
@@ -174,7 +416,12 @@ struct Record
     I::LongSSO<> message;
     I::LongSSO<separator_sso_len> separator {" "};
 
+protected:
+    void init(Severity severity, int line, const char* file, const char* fileOnly, const char* func, int flags);
+
 private:
+    I::LongSSO<fields_sso_len> fields;
+    const Lazy* lazyArgs {}; // Reversed list
     int flags{};
     int skipSeparators{};
 
@@ -182,6 +429,13 @@ private:
     int flagsBckp{};
 
 private:
+    template<typename Func>
+    static inline void forEachContextImpl(const Context* entry, Func& func) {
+        if (!entry) return;
+        forEachContextImpl(entry->parent.get(), func);
+        func(static_cast<const Field&>(entry->value));
+    }
+
     inline void handleSeparators(char /*nextSymbol*/) {
         if (skipSeparators) {
             skipSeparators--;
@@ -245,8 +499,92 @@ inline void onStringQuote2(Record& record) {
     record.onStringQuote2();
 }
 
+// Record with compile-time "plain" policy: strings, characters, booleans and integers are appended
+// directly, without separators, auto quotes and flag checks. Other types fall back to Record operators
+// (flags are off, so the output is the same). SEPS/AUTO_QUOTES flags are ignored by plain appends;
+// calling seps()/quotes() switches the rest of statement to dynamic Record.
+struct PlainRecord : Record
+{
+    [[nodiscard]] static PlainRecord create(Severity severity, int line, const char* file, const char* fileOnly, const char* func);
+
+    PlainRecord&& set_suppressed(uint64_t value) { suppressed = value; return std::move(*this); }
+
+    inline void appendPlain(const char* value) { message.appendString(value, strlen(value)); }
+    inline void appendPlain(std::string_view value) { message.appendString(value.data(), value.size()); }
+    inline void appendPlain(const std::string& value) { message.appendString(value.data(), value.size()); }
+    inline void appendPlain(char value) { message.appendString(&value, 1); }
+    inline void appendPlain(bool value) { if (value) { message.appendString("true", 4); } else { message.appendString("false", 5); } }
+
+    template<typename T, typename std::enable_if_t<std::is_integral_v<T>>* = nullptr>
+    inline void appendPlain(T value)
+    {
+        char str[std::numeric_limits<T>::digits10 + 2];
+        char* const end = jeaiii::to_text_from_integer(str, value);
+        message.appendString(str, end - str);
+    }
+};
+
+namespace RecordPolicy {
+struct Dynamic { using Type = Record; };      // Separators and auto quotes controlled by flags at runtime
+struct Plain   { using Type = PlainRecord; }; // No separators and auto quotes, no flag checks
+} // namespace RecordPolicy
+
+namespace Internal {
+template<typename T>
+struct is_plain_appendable : std::bool_constant<
+    std::is_same_v<T, char*> || std::is_same_v<T, const char*> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, char> || std::is_same_v<T, bool> ||
+    (std::is_integral_v<T> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>)> { };
+
+template<typename T, typename = void>
+struct is_ostreamable : std::false_type { };
+
+template<typename T>
+struct is_ostreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type { };
+
+// Types printed through their operator<<(std::ostream&, const T&). Types, which ALog prints itself or by conversion, are excluded
+template<typename T>
+struct is_ostream_fallback : std::bool_constant<
+    is_ostreamable<T>::value &&
+    !std::is_arithmetic_v<T> && !std::is_enum_v<T> && !std::is_pointer_v<T> && !std::is_array_v<T> &&
+    !std::is_convertible_v<const T&, const char*> && !std::is_convertible_v<const T&, const wchar_t*> &&
+    !std::is_convertible_v<const T&, std::string> && !std::is_convertible_v<const T&, std::wstring>> { };
+
+// Argument of fallback operator. Implicit conversion makes any other ALog operator<< a better match
+class OStreamArg
+{
+public:
+    template<typename T, typename std::enable_if_t<is_ostream_fallback<T>::value>* = nullptr>
+    OStreamArg(const T& value) : m_value(&value), m_write(&writeImpl<T>) { }
+
+    void write(std::ostream& stream) const { m_write(stream, m_value); }
+
+private:
+    template<typename T>
+    static void writeImpl(std::ostream& stream, const void* value) { stream << *static_cast<const T*>(value); }
+
+private:
+    const void* m_value;
+    void (*m_write)(std::ostream&, const void*);
+};
+} // namespace Internal
+
 } // namespace ALog
 
+template<typename T, typename std::enable_if_t<ALog::I::is_plain_appendable<std::decay_t<T>>::value>* = nullptr>
+inline ALog::PlainRecord&& operator<< (ALog::PlainRecord&& record, const T& value)
+{
+    record.appendPlain(value);
+    return std::move(record);
+}
+
+inline ALog::PlainRecord&& operator<< (ALog::PlainRecord&& record, ALog::Record::Flags flag)
+{
+    record.flagsOn(flag);
+    return std::move(record);
+}
+
 
 // --- Forward declarations specially for clang compiler (Mac OS) ---
 namespace ALog {
@@ -505,27 +843,14 @@ inline ALog::Record&& operator<< (ALog::Record&& record, const T* value)
     record.appendMessage("(", 1);
     record.appendMessageAL(typeid(T).name());
     record.appendMessage("*)", 2);
-
-    constexpr size_t bufSz = 16+4;
-    char str[bufSz];
-    size_t len;
-
-    len = snprintf(str, bufSz, "0x%p", value);
-
-    record.appendMessage(str, len);
+    record.appendPointer(value);
     return std::move(record);
 }
 
 inline ALog::Record&& operator<< (ALog::Record&& record, const void* value)
 {
-    constexpr size_t bufSz = 16+4;
-    char str[bufSz];
-    size_t len;
-
-    len = snprintf(str, bufSz, "0x%p", value);
-
     [[maybe_unused]] auto _checkSS = record.updateSkipSeparators(1);
-    record.appendMessage(str, len);
+    record.appendPointer(value);
     return std::move(record);
 }
 
@@ -559,20 +884,20 @@ inline ALog::Record&& operator<< (ALog::Record&& record, T value) { return (std:
 template<typename T, typename std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8>* = nullptr >
 inline ALog::Record&& operator<< (ALog::Record&& record, T value) { return (std::move(record) << (int64_t)value); }
 
-#ifdef ALOG_HAS_QT_LIBRARY
-template<typename T, typename std::enable_if_t<std::is_enum_v<T> && QtPrivate::IsQEnumHelper<T>::Value>* = nullptr>
-inline ALog::Record&& operator<< (ALog::Record&& record, T value) {
-    const auto metaEnum = QMetaEnum::fromType<T>();
+namespace ALog {
+namespace Internal {
 
-    record.appendMessageAL(metaEnum.enumName());
+template<typename T>
+inline void logEnum(Record& record, T value, const EnumTable& table)
+{
+    record.appendMessage(table.typeName(), table.typeNameLen());
     [[maybe_unused]] auto _checkSS = record.updateSkipSeparators(5);
     record.appendMessage("(");
-    record = std::move(record) << static_cast<std::underlying_type_t<T>>(value);
+    (void)(std::move(record) << static_cast<std::underlying_type_t<T>>(value));
     record.appendMessage(", ");
 
-    const auto valueName = metaEnum.valueToKey(static_cast<int>(value));
-    if (valueName) {
-        record.appendMessageAL(valueName);
+    if (const auto entry = table.find(value)) {
+        record.appendMessage(entry->name, entry->len);
     } else {
         record.appendMessage("out-of-range");
 
@@ -581,22 +906,100 @@ inline ALog::Record&& operator<< (ALog::Record&& record, T value) {
     }
 
     record.appendMessage(")");
+}
+
+#ifdef ALOG_HAS_QT_LIBRARY
+template<typename T>
+const EnumTable& qtEnumTable()
+{
+    static const EnumTable table = [](){
+        const auto metaEnum = QMetaEnum::fromType<T>();
+        std::vector<EnumTable::Entry> entries;
+        entries.reserve(metaEnum.keyCount());
+
+        for (int i = 0; i < metaEnum.keyCount(); i++)
+            entries.push_back({metaEnum.value(i), metaEnum.key(i), strlen(metaEnum.key(i))});
+
+        return EnumTable(metaEnum.enumName(), std::move(entries));
+    }();
+
+    return table;
+}
+#endif // ALOG_HAS_QT_LIBRARY
+
+} // namespace Internal
+} // namespace ALog
+
+#ifdef ALOG_HAS_QT_LIBRARY
+template<typename T, typename std::enable_if_t<std::is_enum_v<T> && QtPrivate::IsQEnumHelper<T>::Value>* = nullptr>
+inline ALog::Record&& operator<< (ALog::Record&& record, T value) {
+    ALog::Internal::logEnum(record, value, ALog::Internal::qtEnumTable<T>());
     return std::move(record);
 }
 
 template<typename T, typename std::enable_if_t<std::is_enum_v<T> && !QtPrivate::IsQEnumHelper<T>::Value>* = nullptr>
 inline ALog::Record&& operator<< (ALog::Record&& record, T value) {
-    return (std::move(record) << static_cast<std::underlying_type_t<T>>(value));
+    if constexpr (ALog::EnumNames<T>::value) {
+        ALog::Internal::logEnum(record, value, ALog::EnumNames<T>::table());
+        return std::move(record);
+    } else {
+        return (std::move(record) << static_cast<std::underlying_type_t<T>>(value));
+    }
 }
 #else
 template<typename T, typename std::enable_if_t<std::is_enum_v<T>>* = nullptr>
 inline ALog::Record&& operator<< (ALog::Record&& record, T value) {
-    return (std::move(record) << static_cast<std::underlying_type_t<T>>(value));
+    if constexpr (ALog::EnumNames<T>::value) {
+        ALog::Internal::logEnum(record, value, ALog::EnumNames<T>::table());
+        return std::move(record);
+    } else {
+        return (std::move(record) << static_cast<std::underlying_type_t<T>>(value));
+    }
 }
 #endif // ALOG_HAS_QT_LIBRARY
 
 ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::RawData& value);
 
+// Fallback for types with operator<<(std::ostream&, const T&). Output goes directly to the message,
+// through per-thread reused stream with default formatting state.
+ALog::Record&& operator<< (ALog::Record&& record, const ALog::I::OStreamArg& value);
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Hex& value)
+{
+    record.appendHex(value.value, value.width);
+    return std::move(record);
+}
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Bin& value)
+{
+    record.appendBin(value.value, value.bits);
+    return std::move(record);
+}
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::SampleKey& value)
+{
+    record.sampleKey = value.key;
+    return std::move(record);
+}
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Pointer& value)
+{
+    record.appendPointer(value.ptr);
+    return std::move(record);
+}
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Lazy& lazy)
+{
+    record.appendLazy(lazy);
+    return std::move(record);
+}
+
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Field& field)
+{
+    record.appendField(field);
+    return std::move(record);
+}
+
 inline ALog::Record& operator<< (ALog::Record& record, ALog::Record::SkipSeparator ss)
 {
     record.updateSkipSeparatorsCF(ss.count);
@@ -979,6 +1382,41 @@ inline typename std::enable_if_t<std::is_array<T>::value, ALog::Record>&& operat
     return std::move(record);
 }
 
+#ifdef ALOG_HAS_STD_FORMAT
+namespace ALog {
+namespace Internal {
+
+// Format string is checked at compile time
+template<typename... Args>
+[[nodiscard]] inline Record::Format<Args...> makeFormat(std::format_string<const Args&...> fmt, const Args&... args)
+{
+    return {fmt, {args...}};
+}
+
+} // namespace Internal
+} // namespace ALog
+
+template<typename... Args>
+inline ALog::Record&& operator<< (ALog::Record&& record, const ALog::Record::Format<Args...>& value)
+{
+    record.appendMessage("", 0); // Separator
+    std::apply([&record, &value](const Args&... args) {
+        // Formatted to stack buffer and appended at once. Longer text is formatted again, directly to message.
+        char buffer[256];
+        const auto result = std::format_to_n(buffer, static_cast<std::ptrdiff_t>(sizeof(buffer)), value.fmt, args...);
+        const auto size = static_cast<size_t>(result.size);
+
+        if (size <= sizeof(buffer)) {
+            record.message.allocate_copy(size, buffer);
+        } else {
+            auto target = reinterpret_cast<char*>(record.message.allocate_copy(size));
+            std::format_to(target, value.fmt, args...);
+        }
+    }, value.args);
+    return std::move(record);
+}
+#endif // ALOG_HAS_STD_FORMAT
+
 #ifdef ALOG_CXX23
 template<typename T1, typename T2>
 ALog::Record&& operator<< (ALog::Record&& record, const std::expected<T1, T2>& value)
@@ -1068,3 +1506,16 @@ ALog::Record&& operator<< (ALog::Record&& record, const std::chrono::time_point<
 
 template<typename T> inline ALog::Record& operator<< (ALog::Record& record, T&& value) { return (std::move(record) << std::forward<T&&>(value)); }
 template<typename T> inline ALog::Record& operator<< (ALog::Record& record, const T& value) { return (std::move(record) << value); }
+
+namespace ALog {
+namespace Internal {
+
+// Defined after all operators to see them
+template<typename Func>
+void invokeLazy(const void* func, Record& record)
+{
+    (void)(std::move(record) << (*static_cast<const Func*>(func))());
+}
+
+} // namespace Internal
+} // namespace ALog
@@ -0,0 +1,45 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <atomic>
+#include <utility>
+#include <alog/record.h>
+#include <alog/tools.h>
+
+namespace ALog {
+
+// Immutable record with formatted buffer, shared by intrusive reference counter.
+// Sinks can retain it after ISink::writeHandle returns; copying is cheap.
+class RecordHandle
+{
+public:
+    RecordHandle() = default;
+    RecordHandle(const RecordHandle& rhs) noexcept : m_data(rhs.m_data) { if (m_data) m_data->refs.fetch_add(1, std::memory_order_relaxed); }
+    RecordHandle(RecordHandle&& rhs) noexcept : m_data(std::exchange(rhs.m_data, nullptr)) { }
+    RecordHandle& operator=(RecordHandle rhs) noexcept { std::swap(m_data, rhs.m_data); return *this; }
+    ~RecordHandle() { if (m_data && m_data->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete m_data; }
+
+    [[nodiscard]] static RecordHandle create(const Record& record, const Buffer& buffer) { return RecordHandle(new Data{{1}, record, buffer}); }
+    [[nodiscard]] static RecordHandle create(Record&& record, Buffer&& buffer) { return RecordHandle(new Data{{1}, std::move(record), std::move(buffer)}); }
+
+    explicit operator bool() const { return m_data; }
+    const Record& record() const { assert(m_data); return m_data->record; }
+    const Buffer& buffer() const { assert(m_data); return m_data->buffer; }
+    uint32_t useCount() const { return m_data ? m_data->refs.load(std::memory_order_relaxed) : 0; }
+
+private:
+    struct Data {
+        std::atomic<uint32_t> refs;
+        const Record record;
+        const Buffer buffer;
+    };
+
+    explicit RecordHandle(Data* data) : m_data(data) { }
+
+private:
+    Data* m_data {};
+};
+
+} // namespace ALog
@@ -0,0 +1,122 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <alog/record.h>
+#include <alog/severity.h>
+
+namespace ALog {
+
+// Record for signal handlers: fixed size, no allocations, no locks.
+// Accepts literals, C-strings and char arrays, integers, bool and char only. Longer message is truncated.
+struct SignalRecord
+{
+    static constexpr size_t message_limit = 256;
+
+    [[nodiscard]] static inline SignalRecord create(Severity severity, int line, const char* file, const char* fileOnly, const char* func) noexcept {
+        SignalRecord record;
+        record.severity = severity;
+        record.line = line;
+        record.filenameFull = file;
+        record.filenameOnly = fileOnly;
+        record.func = func;
+        record.steadyTp = std::chrono::steady_clock::now();
+        record.systemTp = std::chrono::system_clock::now();
+        return record;
+    }
+
+    inline void append(const char* str, size_t len) noexcept {
+        const auto available = message_limit - messageLen;
+        if (len > available) len = available;
+        memcpy(message + messageLen, str, len);
+        messageLen += len;
+    }
+
+    template<size_t N>
+    inline SignalRecord&& operator<< (const char(&value)[N]) && noexcept { append(value, strnlen(value, N)); return std::move(*this); }
+    inline SignalRecord&& operator<< (const char* value) && noexcept { if (value) append(value, strlen(value)); return std::move(*this); }
+    inline SignalRecord&& operator<< (char value) && noexcept { append(&value, 1); return std::move(*this); }
+    inline SignalRecord&& operator<< (bool value) && noexcept { value ? append("true", 4) : append("false", 5); return std::move(*this); }
+
+    template<typename T, typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>* = nullptr>
+    inline SignalRecord&& operator<< (T value) && noexcept {
+        char str[std::numeric_limits<T>::digits10 + 3];
+        append(str, jeaiii::to_text_from_integer(str, value) - str);
+        return std::move(*this);
+    }
+
+    // Called by consumer, not signal-safe
+    Record toRecord() const;
+
+    Severity severity {};
+    int line {};
+    const char* filenameFull {};
+    const char* filenameOnly {};
+    const char* func {};
+    const char* module {};
+    std::chrono::time_point<std::chrono::steady_clock> steadyTp;
+    std::chrono::time_point<std::chrono::system_clock> systemTp;
+    size_t messageLen {};
+    char message[message_limit];
+};
+
+namespace Internal {
+
+// Preallocated slots, filled by signal handlers (lock-free) and drained by logger
+class SignalSlots
+{
+    ALOG_NO_COPY_MOVE(SignalSlots);
+public:
+    explicit SignalSlots(size_t count);
+
+    // Async-signal-safe. Returns false if all slots are busy
+    bool push(const SignalRecord& record) noexcept;
+
+    bool hasPending() const noexcept { return m_pending.load(std::memory_order_acquire); }
+    uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+    template<typename Func>
+    size_t drain(const Func& func) {
+        if (!hasPending()) return 0;
+
+        size_t result {};
+        for (size_t i = 0; i < m_count; i++) {
+            auto& slot = m_slots[i];
+            if (slot.state.load(std::memory_order_acquire) != Ready) continue;
+
+            func(slot.record);
+            slot.state.store(Free, std::memory_order_release);
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            result++;
+        }
+
+        return result;
+    }
+
+private:
+    enum State : uint8_t { Free, Writing, Ready };
+    static_assert(std::atomic<uint8_t>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free,
+                  "Signal-safe logging requires lock-free atomics");
+
+    struct Slot {
+        std::atomic<uint8_t> state {Free};
+        SignalRecord record;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_count {};
+    std::atomic<size_t> m_next {};
+    std::atomic<size_t> m_pending {};
+    std::atomic<uint64_t> m_dropped {};
+};
+
+} // namespace Internal
+} // namespace ALog
@@ -6,6 +6,7 @@
 #include <memory>
 #include <functional>
 #include <alog/record.h>
+#include <alog/record_handle.h>
 #include <alog/tools.h>
 
 
@@ -21,6 +22,11 @@ public:
     virtual ~ISink() = default;
     virtual void write(const Buffer& buffer, const Record& record) = 0;
     virtual void flush() { }
+
+    // Sinks which retain records (deferred writing) should return true and override writeHandle.
+    // Chain creates one handle per record for all such sinks instead of passing 'const Record&'.
+    virtual bool acceptsHandles() const { return false; }
+    virtual void writeHandle(const RecordHandle& handle) { write(handle.buffer(), handle.record()); }
 };
 
 using ISinkPtr = std::shared_ptr<ISink>;
@@ -38,6 +44,9 @@ public:
 
     void write(const Buffer& buffer, const Record& record) override;
     void flush() override;
+
+    bool acceptsHandles() const override;
+    void writeHandle(const RecordHandle& handle) override;
 };
 
 
@@ -55,6 +64,22 @@ private:
 using Functor2 = Functor<std::function<void(const Buffer& buffer, const Record&)>>;
 
 
+template<typename T>
+class HandleFunctor : public ISink
+{
+public:
+    HandleFunctor(const T& func): m_func(func) { }
+    void write(const Buffer& buffer, const Record& record) override { m_func(RecordHandle::create(record, buffer)); }
+    bool acceptsHandles() const override { return true; }
+    void writeHandle(const RecordHandle& handle) override { m_func(handle); }
+
+private:
+    T m_func;
+};
+
+using HandleFunctor1 = HandleFunctor<std::function<void(const RecordHandle&)>>;
+
+
 class Null : public ISink
 {
 public:
@@ -21,11 +21,20 @@ public:
 
     void reset();
 
+    // Exchanges filters, formatter, converters and sinks. Not thread-safe (see Logger::reconfigure).
+    void swap(Pipeline& other);
+
     Filters::Chain& filters();
     IFormatterPtr& formatter();
     Converters::Chain& converters();
     Sinks::Chain& sinks();
 
+    // Decision made before message is complete (without message-dependent filters). Empty, if it can't be made.
+    I::optional_bool canPassEarly(const Record& record) const;
+
+    bool canPass(const Record& record) const;
+    void writeUnfiltered(const Buffer& buffer, const Record& record);
+
     void write(const Buffer& buffer, const Record& record) override;
     void flush() override;
 
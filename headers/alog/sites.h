@@ -0,0 +1,118 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include <alog/record.h>
+#include <alog/tools.h>
+
+namespace ALog {
+
+class Sites;
+
+enum class SiteState {
+    Default,  // Record is created and filtered as usual
+    Enabled,  // Record passes severity filters (like ScopedVerbosity)
+    Disabled  // Statement is skipped, arguments are not evaluated. Ignored for Fatal
+};
+
+namespace Internal {
+
+// Per call-site state of logging macros. Constant-initialized, registers itself in ALog::Sites on first execution.
+// Sites are never unregistered, so libraries containing them should not be unloaded.
+class Site
+{
+    friend class ::ALog::Sites;
+public:
+    enum State : int {
+        Unregistered = -1,
+        Default  = static_cast<int>(SiteState::Default),
+        Enabled  = static_cast<int>(SiteState::Enabled),
+        Disabled = static_cast<int>(SiteState::Disabled)
+    };
+
+    struct Decision {
+        State state;
+        bool skip;
+        uint16_t fileId;
+        Site* site;
+        explicit operator bool() const { return skip; }
+    };
+
+    constexpr Site(const char* file, int line) : m_file(file), m_line(line) { }
+
+    template<typename ModuleFunc>
+    inline Decision check(Severity severity, const char* func, const ModuleFunc& module) {
+        auto result = static_cast<State>(m_state.load(std::memory_order_acquire));
+        if (result == Unregistered) result = registerSite(func, module());
+        return {result, result == Disabled && severity != Severity::Fatal, m_fileId, this};
+    }
+
+    template<typename RecordT>
+    static inline RecordT&& apply(RecordT&& record, const Decision& decision) {
+        if (decision.state == Enabled)
+            record.verbosity = Severity::Minimal;
+        record.fileId = decision.fileId;
+        record.site = decision.site;
+        return static_cast<RecordT&&>(record);
+    }
+
+    // Filters verdict for records of this site, cached by logger (see Logger::setProducerFiltering).
+    // Key has lowest bit clear and describes logger, configuration epoch, module and severity
+    inline I::optional_bool cachedVerdict(uint64_t key) const {
+        const auto value = m_verdict.load(std::memory_order_relaxed);
+        if ((value | 1) != (key | 1)) return {};
+        return (value & 1) != 0;
+    }
+
+    inline void cacheVerdict(uint64_t key, bool pass) { m_verdict.store(key | (pass ? 1 : 0), std::memory_order_relaxed); }
+
+private:
+    State registerSite(const char* func, const char* module);
+
+private:
+    const char* m_file;
+    int m_line;
+    const char* m_func {};
+    const char* m_module {};
+    Site* m_next {};
+    uint16_t m_fileId {}; // Published by m_state
+    std::atomic<int> m_state {Unregistered};
+    std::atomic<uint64_t> m_verdict {};
+};
+
+} // namespace Internal
+
+// Runtime control over individual logging statements.
+// Query is space-separated "key value" pairs, all given keys should match:
+//   file <glob>    - full path or file name, e.g. "file net_*.cpp"
+//   func <glob>    - function name
+//   module <glob>  - module name (see DEFINE_ALOGGER_MODULE); main logger has no module
+//   line <N>       - line number
+// Globs support '*' and '?'. Empty query matches everything.
+// Rules are remembered and applied to statements executed later; the last matching rule wins.
+class Sites
+{
+public:
+    struct Info {
+        const char* file;
+        int line;
+        const char* func;
+        const char* module;
+        SiteState state;
+    };
+
+    // Only statements executed at least once are listed
+    static std::vector<Info> list();
+
+    // Returns number of matched listed sites. Throws std::invalid_argument on malformed query.
+    static size_t set(const std::string& query, SiteState state);
+
+    // Drops all rules, all sites return to SiteState::Default
+    static void reset();
+};
+
+} // namespace ALog
@@ -12,6 +12,18 @@
 #include <stdexcept>
 #include <variant>
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+#ifdef __cpp_lib_memory_resource
+#define ALOG_HAS_PMR
+#endif // __cpp_lib_memory_resource
+
+#if defined(ALOG_HAS_PMR) && defined(ALOG_PMR_BUFFER)
+#define ALOG_HAS_PMR_BUFFER
+#endif // ALOG_HAS_PMR && ALOG_PMR_BUFFER
+
 #define ALOG_DECLARE_PIMPL  \
     struct impl_t; \
     std::unique_ptr<impl_t> _impl; \
@@ -71,7 +83,40 @@ enum Comparison1 { Less, GreaterEqual };
 
 enum no_initialization_tag { no_initialization };
 
+#ifdef ALOG_HAS_PMR
+// Memory resource for ALog allocations: logger queues and, with ALOG_PMR_BUFFER, long messages and formatted buffers.
+// nullptr - std::pmr::new_delete_resource(). Memory allocated earlier is returned to its original resource.
+void setMemoryResource(std::pmr::memory_resource* resource);
+std::pmr::memory_resource* memoryResource();
+
+namespace Internal {
+
+// Polymorphic allocator, which uses ALog::memoryResource() by default
+template<typename T>
+class Allocator : public std::pmr::polymorphic_allocator<T>
+{
+public:
+    Allocator() noexcept : std::pmr::polymorphic_allocator<T>(memoryResource()) { }
+    Allocator(std::pmr::memory_resource* resource) noexcept : std::pmr::polymorphic_allocator<T>(resource) { }
+    template<typename U>
+    Allocator(const Allocator<U>& rhs) noexcept : std::pmr::polymorphic_allocator<T>(rhs.resource()) { }
+
+    Allocator select_on_container_copy_construction() const { return Allocator(); }
+};
+
+} // namespace Internal
+#else
+namespace Internal {
+template<typename T>
+using Allocator = std::allocator<T>;
+} // namespace Internal
+#endif // ALOG_HAS_PMR
+
+#ifdef ALOG_HAS_PMR_BUFFER
+using Buffer = std::vector<uint8_t, Internal::Allocator<uint8_t>>; // Not source/ABI compatible with plain vector
+#else
 using Buffer = std::vector<uint8_t>;
+#endif // ALOG_HAS_PMR_BUFFER
 
 namespace Internal {
 
@@ -115,6 +160,68 @@ private:
 template<typename Functor>
 Finally<Functor> CreateFinally(Functor f) { return Finally<Functor>(f); }
 
+// Lookup tables for hex/binary output: byte -> 2 hex digits, nibble -> 4 binary digits
+struct EncodingTables {
+    char hexPairs[256 * 2] {};
+    char binQuads[16 * 4] {};
+
+    constexpr EncodingTables() {
+        constexpr const char digits[] = "0123456789ABCDEF";
+
+        for (int i = 0; i < 256; i++) {
+            hexPairs[i * 2] = digits[i >> 4];
+            hexPairs[i * 2 + 1] = digits[i & 0xF];
+        }
+
+        for (int i = 0; i < 16; i++)
+            for (int j = 0; j < 4; j++)
+                binQuads[i * 4 + j] = (i & (8 >> j)) ? '1' : '0';
+    }
+};
+
+inline constexpr EncodingTables encodingTables {};
+
+// Writes hex digits of value (at least minDigits, at most 16) backwards, ending at 'end'. Returns start.
+inline char* toHexReversed(char* end, uint64_t value, size_t minDigits = 1)
+{
+    char* it = end;
+
+    do {
+        it -= 2;
+        memcpy(it, &encodingTables.hexPairs[(value & 0xFF) * 2], 2);
+        value >>= 8;
+    } while (value);
+
+    if (*it == '0' && end - it > 1)
+        ++it;
+
+    if (minDigits > 16)
+        minDigits = 16;
+
+    while (static_cast<size_t>(end - it) < minDigits)
+        *--it = '0';
+
+    return it;
+}
+
+// Writes 'bits' (multiple of 4, at most 64) lowest binary digits of value. Returns end.
+inline char* toBin(char* out, uint64_t value, size_t bits)
+{
+    for (size_t shift = bits; shift >= 4; shift -= 4, out += 4)
+        memcpy(out, &encodingTables.binQuads[((value >> (shift - 4)) & 0xF) * 4], 4);
+
+    return out;
+}
+
+// Writes 2 hex digits per byte. Returns end.
+inline char* bytesToHex(char* out, const uint8_t* data, size_t sz)
+{
+    for (size_t i = 0; i < sz; i++, out += 2)
+        memcpy(out, &encodingTables.hexPairs[data[i] * 2], 2);
+
+    return out;
+}
+
 template<size_t sso_limit = 79>
 class LongSSO {
 public:
@@ -140,7 +247,7 @@ public:
         if (this == &rhs) return *this;
 
         if (m_deleteLongBuf)
-            delete m_longBuf;
+            destroyBuffer(m_longBuf);
 
         m_isShortBuf = rhs.m_isShortBuf;
         m_deleteLongBuf = rhs.m_deleteLongBuf;
@@ -168,7 +275,7 @@ public:
 
     ~LongSSO() {
         if (m_deleteLongBuf){
-            delete m_longBuf;
+            destroyBuffer(m_longBuf);
             m_deleteLongBuf = false; //False positive, but should do no harm
         }
     }
@@ -220,6 +327,18 @@ public:
         appendString(str, strlen(str));
     }
 
+    // Allows std::back_inserter
+    using value_type = char;
+    void push_back(char c) { *allocate_copy(1) = static_cast<uint8_t>(c); }
+
+    void insert(size_t pos, const char* str, size_t sz) {
+        const auto oldSz = getStringLen();
+        allocate_copy(sz);
+        auto data = getStringRw();
+        memmove(data + pos + sz, data + pos, oldSz - pos);
+        memcpy(data + pos, str, sz);
+    }
+
     template<size_t N>
     void appendString(const char(&str)[N]) {
         appendString(str, N-1);
@@ -270,7 +389,7 @@ private:
         if (m_longBuf) {
             m_longBuf->resize(newSz+1);
         } else {
-            m_longBuf = new Buffer(newSz+1);
+            m_longBuf = createBuffer(newSz+1);
             m_deleteLongBuf = true;
         }
 
@@ -282,6 +401,35 @@ private:
         return m_longBuf->data() + m_sz;
     }
 
+    // Buffer object itself is allocated from the same resource as its data
+    static Buffer* createBuffer(size_t sz) {
+#ifdef ALOG_HAS_PMR_BUFFER
+        Allocator<Buffer> allocator;
+        Buffer* result = allocator.allocate(1);
+
+        try {
+            new (result) Buffer(sz, allocator);
+        } catch (...) {
+            allocator.deallocate(result, 1);
+            throw;
+        }
+
+        return result;
+#else
+        return new Buffer(sz);
+#endif // ALOG_HAS_PMR_BUFFER
+    }
+
+    static void destroyBuffer(Buffer* buffer) {
+#ifdef ALOG_HAS_PMR_BUFFER
+        Allocator<Buffer> allocator(buffer->get_allocator());
+        buffer->~Buffer();
+        allocator.deallocate(buffer, 1);
+#else
+        delete buffer;
+#endif // ALOG_HAS_PMR_BUFFER
+    }
+
 private:
     uint8_t m_buf[sso_limit+1];
     size_t m_sz { 0 };
@@ -412,6 +560,16 @@ const char* currentThreadName();
 } // namespace ThreadTools
 
 
+// Small integer IDs of module and file names (by content), used by compiled filters (see Filters::Chain).
+// 0 means "not interned": nullptr or tables are full. IDs are never released.
+uint16_t internModule(const char* name);
+uint16_t internFile(const char* name);
+
+// Incremented on each change of filters, sinks and loggers. Invalidates filter verdicts cached by call-sites
+uint32_t configEpoch();
+void bumpConfigEpoch();
+
+
 // This implementation is 2 to 3 times faster
 #pragma pack(push, 1)
 class optional_bool
@@ -487,20 +645,27 @@ public:
     template<typename T, typename... Args>
     void set(Args&&... args) { set(std::make_shared<T>(std::forward<Args>(args)...)); }
 
-    IChain<Interface, Class>& add(const ItemPtr& item) { m_items.push_back(item); return *this; }
+    IChain<Interface, Class>& add(const ItemPtr& item) { m_items.push_back(item); changed(); return *this; }
     template<typename T, typename... Args>
     IChain<Interface, Class>& add(Args&&... args) { return add(std::make_shared<T>(std::forward<Args>(args)...)); }
     IChain<Interface, Class>& add(const std::initializer_list<ItemPtr>& items) {
         for (const auto& x : items) m_items.push_back(x);
+        changed();
         return *this;
     }
-    virtual void clear() { m_items.clear(); }
+    virtual void clear() { m_items.clear(); changed(); }
     bool empty() const { return m_items.empty(); }
 
 protected:
     using Items = std::vector<ItemPtr>;
     const Items& items() const { return m_items; }
 
+    // Called after items are added or removed. Not called from constructor
+    virtual void onChanged() { }
+
+    // Should be called by derived classes after other changes affecting decisions
+    void changed() { onChanged(); bumpConfigEpoch(); }
+
 private:
     Items m_items;
 };
@@ -9,6 +9,7 @@
 #include <string>
 #include <tuple>
 #include <alog/severity.h>
+#include <alog/tools.h>
 
 namespace ALog {
 namespace Internal {
@@ -31,5 +32,8 @@ bool enableColoredTerminal(FILE* stream = stdout);
 const std::string& getSeverityColorCode(Severity severity);
 const std::string& getResetColorCode();
 
+// Appends quoted string with JSON escaping
+void appendJsonString(LongSSO<>& out, const char* str, size_t len);
+
 } // namespace Internal
 } // namespace ALog
@@ -0,0 +1,203 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/aggregate.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ALog {
+
+namespace {
+
+constexpr size_t shardsCount = 8;
+
+// Histogram: exact buckets for [0, 16), then 8 sub-buckets per power of 2 (relative error up to 6.25%)
+constexpr size_t directBuckets = 16;
+constexpr int subBucketBits = 3;
+constexpr size_t bucketsCount = directBuckets + (64 - 4) * (1 << subBucketBits);
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+int highestBit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int result = 0;
+    while (value >>= 1) result++;
+    return result;
+#endif
+}
+
+size_t bucketOf(double value)
+{
+    if (!(value > 0)) return 0; // Negatives and NaN
+    if (value >= 18446744073709551615.0) return bucketsCount - 1;
+
+    const auto x = static_cast<uint64_t>(value);
+    if (x < directBuckets) return static_cast<size_t>(x);
+
+    const auto exp = highestBit(x);
+    const auto sub = (x >> (exp - subBucketBits)) & ((1 << subBucketBits) - 1);
+    return directBuckets + static_cast<size_t>(exp - 4) * (1 << subBucketBits) + static_cast<size_t>(sub);
+}
+
+double bucketValue(size_t bucket)
+{
+    if (bucket < directBuckets) return static_cast<double>(bucket);
+
+    const auto exp = static_cast<int>((bucket - directBuckets) >> subBucketBits) + 4;
+    const auto sub = (bucket - directBuckets) & ((1 << subBucketBits) - 1);
+    const auto width = std::ldexp(1.0, exp - subBucketBits);
+    return static_cast<double>((1 << subBucketBits) + sub) * width + width / 2;
+}
+
+template<typename Func>
+void atomicUpdate(std::atomic<double>& target, double value, const Func& func)
+{
+    auto current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, func(current, value), std::memory_order_relaxed)) { }
+}
+
+struct alignas(64) Shard
+{
+    std::atomic<uint64_t> count {};
+    std::atomic<double> sum {0.0};
+    std::atomic<double> min {infinity};
+    std::atomic<double> max {-infinity};
+    std::atomic<uint32_t> buckets[bucketsCount] {};
+};
+
+} // namespace
+
+namespace Internal {
+
+struct AggregateSite::Data
+{
+    const char* name;
+    const char* file;
+    const char* fileOnly;
+    int line;
+    const char* func;
+    const char* module;
+    uint16_t moduleId;
+    uint16_t fileId;
+    Shard shards[shardsCount];
+};
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<AggregateSite::Data>> sites;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+AggregateSite::Data* AggregateSite::registerSite(const char* func, const char* module)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    if (const auto current = m_data.load(std::memory_order_acquire))
+        return current;
+
+    auto data = std::make_unique<Data>();
+    data->name = m_name;
+    data->file = m_file;
+    data->fileOnly = m_fileOnly;
+    data->line = m_line;
+    data->func = func;
+    data->module = module;
+    data->moduleId = internModule(module);
+    data->fileId = internFile(m_fileOnly);
+
+    const auto result = data.get();
+    reg.sites.emplace_back(std::move(data));
+    m_data.store(result, std::memory_order_release);
+    return result;
+}
+
+void AggregateSite::addImpl(Data& data, double value)
+{
+    auto& shard = data.shards[static_cast<size_t>(ThreadTools::currentThreadId()) % shardsCount];
+
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    atomicUpdate(shard.sum, value, [](double a, double b){ return a + b; });
+    atomicUpdate(shard.min, value, [](double a, double b){ return b < a ? b : a; });
+    atomicUpdate(shard.max, value, [](double a, double b){ return b > a ? b : a; });
+    shard.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AggregateSite::collect(Severity severity, const std::function<void(Record&&)>& func)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    std::vector<uint64_t> buckets(bucketsCount);
+
+    for (const auto& site : reg.sites) {
+        uint64_t count {};
+        double sum {};
+        double min = infinity;
+        double max = -infinity;
+        std::fill(buckets.begin(), buckets.end(), 0);
+
+        // Samples added concurrently may be reported in next interval
+        for (auto& shard : site->shards) {
+            if (!shard.count.load(std::memory_order_relaxed)) continue;
+
+            count += shard.count.exchange(0, std::memory_order_relaxed);
+            sum += shard.sum.exchange(0.0, std::memory_order_relaxed);
+            min = (std::min)(min, shard.min.exchange(infinity, std::memory_order_relaxed));
+            max = (std::max)(max, shard.max.exchange(-infinity, std::memory_order_relaxed));
+
+            for (size_t i = 0; i < bucketsCount; i++)
+                if (shard.buckets[i].load(std::memory_order_relaxed))
+                    buckets[i] += shard.buckets[i].exchange(0, std::memory_order_relaxed);
+        }
+
+        if (!count) continue;
+
+        const auto rank = static_cast<uint64_t>(std::ceil(static_cast<double>(count) * 0.99));
+        double p99 = max;
+        uint64_t accumulated {};
+
+        for (size_t i = 0; i < bucketsCount; i++) {
+            accumulated += buckets[i];
+            if (accumulated >= rank) {
+                p99 = (std::max)(min, (std::min)(max, bucketValue(i)));
+                break;
+            }
+        }
+
+        auto record = Record::create(severity, site->line, site->file, site->fileOnly, site->func);
+        record.module = site->module;
+        record.moduleId = site->moduleId;
+        record.fileId = site->fileId;
+        record.context.reset();   // Belongs to flushing thread, not to the aggregate
+        record.verbosity.reset();
+        record.appendMessageAL(site->name);
+        record.appendField(Record::Field::create("count", count));
+        record.appendField(Record::Field::create("min", min));
+        record.appendField(Record::Field::create("max", max));
+        record.appendField(Record::Field::create("mean", sum / static_cast<double>(count)));
+        record.appendField(Record::Field::create("p99", p99));
+        func(std::move(record));
+    }
+}
+
+} // namespace Internal
+} // namespace ALog
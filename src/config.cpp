@@ -0,0 +1,341 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/config.h>
+
+#include <alog/filters/multi_substring.h>
+#include <alog/filters/regex.h>
+#include <alog/filters/severity.h>
+#include <alog/filters/severity_module.h>
+#include <alog/formatters/default.h>
+#include <alog/formatters/json.h>
+#include <alog/formatters/minimal.h>
+#include <alog/sinks/file.h>
+#include <alog/sinks/file_rotated.h>
+#include <alog/sinks/pipeline.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace ALog {
+
+namespace {
+
+std::string trimmed(const std::string& str)
+{
+    const auto isSpace = [](char c){ return std::isspace(static_cast<unsigned char>(c)); };
+    const auto begin = std::find_if_not(str.begin(), str.end(), isSpace);
+    const auto end = std::find_if_not(str.rbegin(), str.rend(), isSpace).base();
+    return begin < end ? std::string(begin, end) : std::string();
+}
+
+std::string lowered(std::string str)
+{
+    for (auto& c : str)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return str;
+}
+
+class Parser
+{
+public:
+    explicit Parser(Config& config): m_config(config) { }
+
+    void parse(const std::string& text) {
+        std::istringstream stream(text);
+        std::string line;
+
+        while (std::getline(stream, line)) {
+            m_line++;
+            line = trimmed(line);
+
+            if (line.empty() || line[0] == ';' || line[0] == '#')
+                continue;
+
+            if (line.front() == '[') {
+                if (line.back() != ']') fail("expected ']'");
+                section(trimmed(line.substr(1, line.size() - 2)));
+                continue;
+            }
+
+            const auto eq = line.find('=');
+            if (eq == std::string::npos) fail("expected 'key = value'");
+
+            const auto key = trimmed(line.substr(0, eq));
+            if (key.empty()) fail("empty key");
+
+            value(key, trimmed(line.substr(eq + 1)));
+        }
+
+        for (const auto& sink : m_config.sinks)
+            if (sink.type != Config::Sink::Type::Console && sink.path.empty())
+                throw std::invalid_argument("ALog::Config: sink '" + sink.name + "' has no path");
+    }
+
+private:
+    enum class Section { None, Logger, Levels, Filters, Formatter, Sink };
+
+    [[noreturn]] void fail(const std::string& error) const {
+        throw std::invalid_argument("ALog::Config: line " + std::to_string(m_line) + ": " + error);
+    }
+
+    void section(const std::string& name) {
+        const auto lname = lowered(name);
+
+        if (lname == "logger") { m_section = Section::Logger; return; }
+        if (lname == "levels") { m_section = Section::Levels; return; }
+        if (lname == "filters") { m_section = Section::Filters; return; }
+        if (lname == "formatter") { m_section = Section::Formatter; return; }
+
+        if (lname.compare(0, 5, "sink.") == 0 && name.size() > 5) {
+            const auto sinkName = name.substr(5);
+            for (const auto& x : m_config.sinks)
+                if (x.name == sinkName) fail("duplicate sink '" + sinkName + "'");
+
+            m_config.sinks.emplace_back();
+            m_config.sinks.back().name = sinkName;
+            m_section = Section::Sink;
+            return;
+        }
+
+        fail("unknown section '" + name + "'");
+    }
+
+    void value(const std::string& key, const std::string& value) {
+        const auto lkey = lowered(key);
+
+        switch (m_section) {
+            case Section::None:
+                fail("key '" + key + "' outside of section");
+
+            case Section::Logger:
+                if (lkey == "mode") {
+                    m_config.mode = choice<Logger::LoggerMode>(value, {{"sync", Logger::Synchronous},
+                                                                       {"async", Logger::Asynchronous},
+                                                                       {"async-sort", Logger::AsynchronousSort}});
+                } else if (lkey == "autoflush") {
+                    m_config.autoflush = boolean(value);
+                } else if (lkey == "producer_filtering") {
+                    m_config.producerFiltering = boolean(value);
+                } else {
+                    unknownKey(key);
+                }
+                break;
+
+            case Section::Levels:
+                if (lkey == "default") {
+                    m_config.defaultLevel = severity(value);
+                } else {
+                    for (const auto& x : m_config.moduleLevels)
+                        if (x.first == key) fail("duplicate module '" + key + "'");
+
+                    m_config.moduleLevels.emplace_back(key, severity(value));
+                }
+                break;
+
+            case Section::Filters:
+                if (lkey == "reject") {
+                    std::istringstream stream(value);
+                    std::string item;
+                    while (std::getline(stream, item, ','))
+                        if (!(item = trimmed(item)).empty())
+                            m_config.reject.push_back(item);
+                } else if (lkey == "reject_regex") {
+                    m_config.rejectRegex = value;
+                } else if (lkey == "case_sensitive") {
+                    m_config.caseSensitive = boolean(value);
+                } else {
+                    unknownKey(key);
+                }
+                break;
+
+            case Section::Formatter:
+                if (lkey == "type") {
+                    m_config.formatter = choice<Config::FormatterType>(value, {{"default", Config::FormatterType::Default},
+                                                                               {"minimal", Config::FormatterType::Minimal},
+                                                                               {"json", Config::FormatterType::Json}});
+                } else if (lkey == "datetime") {
+                    m_config.dateTime = boolean(value);
+                } else if (lkey == "local_timestamp") {
+                    m_config.localTimestamp = boolean(value);
+                } else {
+                    unknownKey(key);
+                }
+                break;
+
+            case Section::Sink:
+                sinkValue(m_config.sinks.back(), key, lkey, value);
+                break;
+        }
+    }
+
+    void sinkValue(Config::Sink& sink, const std::string& key, const std::string& lkey, const std::string& value) {
+        using Type = Config::Sink::Type;
+        using Stream = Sinks::Console::Stream;
+        using ColorMode = Sinks::Console::ColorMode;
+
+        if (lkey == "type") {
+            sink.type = choice<Type>(value, {{"console", Type::Console}, {"file", Type::File}, {"file_rotated", Type::FileRotated}});
+        } else if (lkey == "stream") {
+            sink.stream = choice<Stream>(value, {{"stdout", Stream::StdOut}, {"stderr", Stream::StdErr}});
+        } else if (lkey == "colors") {
+            sink.colors = choice<ColorMode>(value, {{"auto", ColorMode::Auto}, {"force", ColorMode::Force}, {"disable", ColorMode::Disable}});
+        } else if (lkey == "path") {
+            if (value.empty()) fail("empty path");
+            sink.path = value;
+        } else if (lkey == "create_path") {
+            sink.createPath = boolean(value);
+        } else if (lkey == "max_size") {
+            sink.maxSize = number(value);
+        } else if (lkey == "max_age") {
+            sink.maxAge = number(value);
+        } else if (lkey == "max_count") {
+            sink.maxCount = number(value);
+        } else {
+            unknownKey(key);
+        }
+    }
+
+    [[noreturn]] void unknownKey(const std::string& key) const {
+        fail("unknown key '" + key + "'");
+    }
+
+    template<typename T>
+    T choice(const std::string& value, std::initializer_list<std::pair<const char*, T>> options) const {
+        const auto lvalue = lowered(value);
+
+        for (const auto& x : options)
+            if (lvalue == x.first)
+                return x.second;
+
+        fail("unexpected value '" + value + "'");
+    }
+
+    bool boolean(const std::string& value) const {
+        return choice<bool>(value, {{"true", true}, {"yes", true}, {"on", true}, {"1", true},
+                                    {"false", false}, {"no", false}, {"off", false}, {"0", false}});
+    }
+
+    Severity severity(const std::string& value) const {
+        return choice<Severity>(value, {{"verbose", Severity::Verbose}, {"debug", Severity::Debug}, {"info", Severity::Info},
+                                        {"warning", Severity::Warning}, {"error", Severity::Error}, {"fatal", Severity::Fatal}});
+    }
+
+    size_t number(const std::string& value) const {
+        if (value.empty() || value.size() > 19 || !std::all_of(value.begin(), value.end(), [](char c){ return c >= '0' && c <= '9'; }))
+            fail("expected number, got '" + value + "'");
+
+        return static_cast<size_t>(std::stoull(value));
+    }
+
+private:
+    Config& m_config;
+    Section m_section { Section::None };
+    size_t m_line {};
+};
+
+} // namespace
+
+Config Config::parse(const std::string& text)
+{
+    Config result;
+    Parser(result).parse(text);
+    return result;
+}
+
+Config Config::load(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("ALog::Config: can't open file '" + fileName + "'");
+
+    std::ostringstream text;
+    text << file.rdbuf();
+
+    if (file.bad())
+        throw std::runtime_error("ALog::Config: can't read file '" + fileName + "'");
+
+    return parse(text.str());
+}
+
+void Config::createPipeline(Sinks::Pipeline& pipeline) const
+{
+    pipeline.reset();
+
+    // Message filters go first, as they only reject. Levels alone keep chain compilable (see Filters::Chain).
+    auto& filters = pipeline.filters();
+
+    if (!reject.empty())
+        filters.add(std::make_shared<Filters::MultiSubstring>(reject, false, caseSensitive, IFilter::RejectOrUndefined));
+
+    if (!rejectRegex.empty())
+        filters.add(std::make_shared<Filters::Regex>(rejectRegex.c_str(), false, caseSensitive, IFilter::RejectOrUndefined));
+
+    for (const auto& x : moduleLevels)
+        filters.add(std::make_shared<Filters::SeverityModule>(x.second, x.first.c_str()));
+
+    if (defaultLevel)
+        filters.add(std::make_shared<Filters::Severity>(*defaultLevel));
+
+    switch (formatter) {
+        case FormatterType::Default: {
+            Internal::Flags<Formatters::Default::Flag> flags;
+            if (dateTime) flags |= Formatters::Default::Flag::DateTime;
+            if (localTimestamp) flags |= Formatters::Default::Flag::LocalTimestamp;
+            pipeline.formatter() = std::make_shared<Formatters::Default>(flags);
+            break;
+        }
+
+        case FormatterType::Minimal:
+            pipeline.formatter() = std::make_shared<Formatters::Minimal>();
+            break;
+
+        case FormatterType::Json:
+            pipeline.formatter() = std::make_shared<Formatters::Json>();
+            break;
+    }
+
+    if (sinks.empty()) {
+        pipeline.sinks().set(std::make_shared<Sinks::Console>());
+        return;
+    }
+
+    for (const auto& x : sinks) {
+        switch (x.type) {
+            case Sink::Type::Console:
+                pipeline.sinks().add(std::make_shared<Sinks::Console>(x.stream, x.colors));
+                break;
+
+            case Sink::Type::File:
+                pipeline.sinks().add(std::make_shared<Sinks::File>(x.path.c_str(), x.createPath));
+                break;
+
+            case Sink::Type::FileRotated:
+                pipeline.sinks().add(std::make_shared<Sinks::FileRotated>(x.path, x.createPath, x.maxSize, x.maxAge, x.maxCount));
+                break;
+        }
+    }
+}
+
+void Config::applyPipeline(Logger& logger) const
+{
+    Sinks::Pipeline pipeline;
+    createPipeline(pipeline);
+    logger.reconfigure(pipeline);
+}
+
+void Config::apply(Logger& logger) const
+{
+    applyPipeline(logger);
+
+    if (mode) logger.setMode(*mode);
+    if (autoflush) logger.setAutoflush(*autoflush);
+    if (producerFiltering) logger.setProducerFiltering(*producerFiltering);
+}
+
+} // namespace ALog
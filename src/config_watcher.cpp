@@ -0,0 +1,190 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/config_watcher.h>
+#include <alog/tools_filesystem.h>
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace ALog {
+
+struct ConfigWatcher::impl_t
+{
+    Logger& logger;
+    std::string fileName;
+    ErrorHandler onError;
+    std::chrono::milliseconds pollInterval;
+
+    std::mutex reloadMutex;
+    std::atomic<uint64_t> reloads {};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool exitFlag {};
+    std::thread thread;
+
+#ifdef __linux__
+    int inotifyFd { -1 };
+    int wakeFd { -1 };
+#endif // __linux__
+
+    impl_t(Logger& logger, const std::string& fileName, ErrorHandler&& onError, std::chrono::milliseconds pollInterval)
+        : logger(logger), fileName(fileName), onError(std::move(onError)), pollInterval(pollInterval) { }
+};
+
+namespace {
+
+// Modification time and size, empty if file is missing
+std::string fileStamp(const std::string& fileName)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(fileName, ec);
+    if (ec) return {};
+
+    const auto size = std::filesystem::file_size(fileName, ec);
+    if (ec) return {};
+
+    return std::to_string(time.time_since_epoch().count()) + ":" + std::to_string(size);
+}
+
+} // namespace
+
+ConfigWatcher::ConfigWatcher(Logger& logger, const std::string& fileName, ErrorHandler onError, std::chrono::milliseconds pollInterval)
+{
+    createImpl(logger, fileName, std::move(onError), pollInterval);
+
+#ifdef __linux__
+    // Directory is watched, so files replaced by rename (as editors do) are tracked too
+    auto dir = std::filesystem::path(fileName).parent_path();
+    if (dir.empty()) dir = ".";
+
+    impl().inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    impl().wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (impl().inotifyFd < 0 || impl().wakeFd < 0 ||
+        inotify_add_watch(impl().inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        // Polling then
+        if (impl().inotifyFd >= 0) close(impl().inotifyFd);
+        if (impl().wakeFd >= 0) close(impl().wakeFd);
+        impl().inotifyFd = impl().wakeFd = -1;
+    }
+#endif // __linux__
+
+    impl().thread = std::thread([this](){ threadFunc(); });
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lck(impl().mutex);
+        impl().exitFlag = true;
+        impl().cv.notify_one();
+    }
+
+#ifdef __linux__
+    if (impl().wakeFd >= 0) {
+        const uint64_t value = 1;
+        (void)!write(impl().wakeFd, &value, sizeof(value));
+    }
+#endif // __linux__
+
+    impl().thread.join();
+
+#ifdef __linux__
+    if (impl().inotifyFd >= 0) close(impl().inotifyFd);
+    if (impl().wakeFd >= 0) close(impl().wakeFd);
+#endif // __linux__
+}
+
+bool ConfigWatcher::reload()
+{
+    std::lock_guard<std::mutex> lck(impl().reloadMutex);
+
+    try {
+        Config::load(impl().fileName).applyPipeline(impl().logger);
+    } catch (const std::exception& e) {
+        if (impl().onError) {
+            try {
+                impl().onError(e.what());
+            } catch (...) {
+                // Throwing handler shouldn't terminate watcher thread
+            }
+        }
+
+        return false;
+    }
+
+    impl().reloads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t ConfigWatcher::reloads() const
+{
+    return impl().reloads.load(std::memory_order_relaxed);
+}
+
+void ConfigWatcher::threadFunc()
+{
+#ifdef __linux__
+    if (impl().inotifyFd >= 0) {
+        const auto name = std::filesystem::path(impl().fileName).filename().string();
+        alignas(inotify_event) char buffer[4096];
+
+        while (true) {
+            pollfd fds[2] = {{impl().inotifyFd, POLLIN, 0}, {impl().wakeFd, POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                break; // Polling then
+            }
+
+            if (fds[1].revents) return;
+
+            bool changed {};
+            ssize_t len;
+
+            while ((len = read(impl().inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t i = 0; i < len; ) {
+                    const auto event = reinterpret_cast<const inotify_event*>(buffer + i);
+                    changed |= event->len && name == event->name;
+
+                    i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+
+            if (changed)
+                reload();
+        }
+    }
+#endif // __linux__
+
+    auto stamp = fileStamp(impl().fileName);
+    std::unique_lock<std::mutex> lck(impl().mutex);
+
+    while (!impl().cv.wait_for(lck, impl().pollInterval, [this](){ return impl().exitFlag; })) {
+        const auto current = fileStamp(impl().fileName);
+        if (current == stamp) continue;
+
+        stamp = current;
+        if (current.empty()) continue; // Removed, possibly to be replaced
+
+        lck.unlock();
+        reload();
+        lck.lock();
+    }
+}
+
+} // namespace ALog
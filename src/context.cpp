@@ -0,0 +1,70 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/context.h>
+
+namespace ALog {
+
+namespace {
+
+std::shared_ptr<const Record::Context>& accessContext()
+{
+    thread_local std::shared_ptr<const Record::Context> context;
+    return context;
+}
+
+// Trivial type, so access is cheap for threads which never set it
+thread_local int verbosityOverride = -1;
+
+} // namespace
+
+ScopedContext::~ScopedContext()
+{
+    accessContext() = std::move(m_previous);
+}
+
+void ScopedContext::push(const Record::Field& value)
+{
+    auto& context = accessContext();
+
+    auto entry = std::make_shared<Record::Context>();
+    entry->value = value;
+
+    if (value.type == Record::Field::Type::String) {
+        entry->storage.assign(value.str, value.strLen);
+        entry->value.str = entry->storage.data();
+    }
+
+    entry->parent = context;
+    m_previous = context;
+    context = std::move(entry);
+}
+
+ScopedVerbosity::ScopedVerbosity(Severity severity)
+    : m_previous(Internal::currentVerbosity())
+{
+    verbosityOverride = severity;
+}
+
+ScopedVerbosity::~ScopedVerbosity()
+{
+    verbosityOverride = m_previous ? *m_previous : -1;
+}
+
+namespace Internal {
+
+const std::shared_ptr<const Record::Context>& currentContext()
+{
+    return accessContext();
+}
+
+std::optional<Severity> currentVerbosity()
+{
+    if (verbosityOverride < 0) return {};
+    return static_cast<Severity>(verbosityOverride);
+}
+
+} // namespace Internal
+
+} // namespace ALog
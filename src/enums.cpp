@@ -0,0 +1,93 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/enums.h>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace ALog {
+namespace Internal {
+
+namespace {
+constexpr uint64_t denseLimit = 4096;
+} // namespace
+
+EnumTable::EnumTable(const char* typeName, std::vector<Entry> entries)
+    : m_typeName(typeName),
+      m_typeNameLen(strlen(typeName)),
+      m_entries(std::move(entries))
+{
+    // First name of value wins
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs){ return lhs.value < rhs.value; });
+    m_entries.erase(std::unique(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs){ return lhs.value == rhs.value; }), m_entries.end());
+
+    if (m_entries.empty())
+        return;
+
+    const auto minValue = m_entries.front().value;
+    const auto maxValue = m_entries.back().value;
+
+    const auto range = static_cast<uint64_t>(maxValue) - static_cast<uint64_t>(minValue);
+
+    if (range < denseLimit) {
+        m_dense.assign(static_cast<size_t>(range + 1), -1);
+        for (size_t i = 0; i < m_entries.size(); i++)
+            m_dense[static_cast<size_t>(static_cast<uint64_t>(m_entries[i].value) - static_cast<uint64_t>(minValue))] = static_cast<int32_t>(i);
+    }
+}
+
+const EnumTable::Entry* EnumTable::findImpl(int64_t value) const
+{
+    if (m_entries.empty())
+        return nullptr;
+
+    if (!m_dense.empty()) {
+        const auto offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(m_entries.front().value);
+        if (value < m_entries.front().value || offset >= m_dense.size())
+            return nullptr;
+
+        const auto index = m_dense[static_cast<size_t>(offset)];
+        return (index < 0) ? nullptr : &m_entries[static_cast<size_t>(index)];
+    }
+
+    const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), value, [](const Entry& lhs, int64_t rhs){ return lhs.value < rhs; });
+    return (it != m_entries.end() && it->value == value) ? &*it : nullptr;
+}
+
+void EnumTable::addReflected(std::vector<Entry>& result, int64_t value, const char* signature)
+{
+    // GCC:   "... [with T = Color; T Value = Color::Red]" or "... = (Color)5]"
+    // Clang: "... [T = Color, Value = Color::Red]"         or "... = (Color)5]"
+    // MSVC:  "...enumSignature<enum Color,Color::Red>(void)" or "...,0x5>(void)"
+    const char* begin;
+    const char* end;
+
+#ifdef _MSC_VER
+    end = strrchr(signature, '>');
+    if (!end) return;
+    begin = end;
+    while (begin > signature && begin[-1] != ',') --begin;
+#else
+    begin = strrchr(signature, '=');
+    if (!begin) return;
+    ++begin;
+    while (*begin == ' ') ++begin;
+    end = begin;
+    while (*end && *end != ']' && *end != ';') ++end;
+#endif
+
+    if (begin == end || *begin == '(' || *begin == '-' || isdigit(static_cast<unsigned char>(*begin)))
+        return;
+
+    for (auto it = begin; it + 1 < end; ++it)
+        if (it[0] == ':' && it[1] == ':')
+            begin = it + 2;
+
+    result.push_back({value, begin, static_cast<size_t>(end - begin)});
+}
+
+} // namespace Internal
+} // namespace ALog
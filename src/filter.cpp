@@ -4,6 +4,7 @@
 
 #include <alog/filter.h>
 
+#include <algorithm>
 #include <string>
 
 namespace ALog {
@@ -40,13 +41,124 @@ Internal::optional_bool IFilter::canPass(const Record& record) const
 
 namespace Filters {
 
+namespace {
+
+constexpr size_t severitiesCount = Severity::COUNT;
+constexpr size_t maxTableSize = 1 << 16;
+
+void sortUnique(std::vector<std::string>& values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+// Name which isn't compared by any filter
+std::string otherName(const std::vector<std::string>& sortedNames)
+{
+    std::string result = "?";
+    while (std::binary_search(sortedNames.begin(), sortedNames.end(), result))
+        result += '?';
+    return result;
+}
+
+// Maps interned IDs to slots: named ones first, then "other" for the rest
+template<typename InternFunc>
+bool createSlots(const std::vector<std::string>& names, const InternFunc& intern, std::vector<uint16_t>& slots)
+{
+    std::vector<uint16_t> ids;
+
+    for (const auto& x : names) {
+        const auto id = intern(x.c_str());
+        if (!id) return false;
+        ids.push_back(id);
+    }
+
+    const auto maxId = ids.empty() ? 0 : *std::max_element(ids.begin(), ids.end());
+    slots.assign(maxId + 1, static_cast<uint16_t>(names.size()));
+
+    for (size_t i = 0; i < ids.size(); i++)
+        slots[ids[i]] = static_cast<uint16_t>(i);
+
+    return true;
+}
+
+} // namespace
+
+// Decisions for: modules (named, "other", none) x files (named, "other") x severities
+struct Chain::Table
+{
+    std::vector<uint16_t> moduleSlots; // By module ID
+    std::vector<uint16_t> fileSlots;   // By file ID, empty if files aren't compared
+    size_t otherModule {};
+    size_t noModule {};
+    size_t otherFile {};
+    size_t filesCount {};
+    std::vector<uint8_t> decisions;
+
+    I::optional_bool lookup(const Record& record) const {
+        // Verbosity override and records created without site or logger entry are evaluated as usual
+        if (record.verbosity) return {};
+
+        size_t module;
+        if (!record.module) {
+            module = noModule;
+        } else if (record.moduleId) {
+            module = record.moduleId < moduleSlots.size() ? moduleSlots[record.moduleId] : otherModule;
+        } else {
+            return {};
+        }
+
+        size_t file {};
+        if (!fileSlots.empty()) {
+            if (!record.fileId) return {};
+            file = record.fileId < fileSlots.size() ? fileSlots[record.fileId] : otherFile;
+        }
+
+        const auto severity = static_cast<size_t>(record.severity);
+        if (severity >= severitiesCount) return {};
+
+        return decisions[(module * filesCount + file) * severitiesCount + severity] != 0;
+    }
+};
+
+Chain::Chain()
+    : Chain(true)
+{
+}
+
+Chain::Chain(const std::initializer_list<IFilterPtr>& filters)
+    : Chain(true, filters)
+{
+}
+
+Chain::Chain(bool compiled, const std::initializer_list<IFilterPtr>& filters)
+    : Internal::IChain<IFilter, Chain>(filters)
+{
+    if (compiled)
+        compile();
+}
+
+Chain::~Chain()
+{
+}
+
 void Chain::clear()
 {
-    Internal::IChain<IFilter, Chain>::clear();
     m_defaultDecision = true;
+    Internal::IChain<IFilter, Chain>::clear();
 }
 
 I::optional_bool Chain::canPass(const Record& record) const
+{
+    if (m_table) {
+        const auto result = m_table->lookup(record);
+        if (result.has_value()) return result;
+    }
+
+    return evaluate(record);
+}
+
+bool Chain::evaluate(const Record& record) const
 {
     I::optional_bool result;
 
@@ -58,6 +170,70 @@ I::optional_bool Chain::canPass(const Record& record) const
     return result.value_or(m_defaultDecision);
 }
 
+bool Chain::collectItemsKeys(TableKeys& keys) const
+{
+    for (const auto& x : items())
+        if (!x->collectTableKeys(keys)) return false;
+
+    return true;
+}
+
+void Chain::compile()
+{
+    m_table.reset();
+
+    TableKeys keys;
+    if (!collectItemsKeys(keys)) return;
+
+    sortUnique(keys.modules);
+    sortUnique(keys.files);
+
+    auto table = std::make_unique<Table>();
+    if (!createSlots(keys.modules, I::internModule, table->moduleSlots)) return;
+    if (!keys.files.empty() && !createSlots(keys.files, I::internFile, table->fileSlots)) return;
+
+    table->otherModule = keys.modules.size();
+    table->noModule = keys.modules.size() + 1;
+    table->otherFile = keys.files.size();
+    table->filesCount = keys.files.size() + 1;
+
+    const auto modulesCount = keys.modules.size() + 2;
+    if (modulesCount * table->filesCount * severitiesCount > maxTableSize) return;
+
+    const auto otherModule = otherName(keys.modules);
+    const auto otherFile = otherName(keys.files);
+    table->decisions.reserve(modulesCount * table->filesCount * severitiesCount);
+
+    for (size_t m = 0; m < modulesCount; m++) {
+        const auto module = m < keys.modules.size() ? keys.modules[m].c_str() :
+                            m == table->otherModule ? otherModule.c_str() : nullptr;
+
+        for (size_t f = 0; f < table->filesCount; f++) {
+            const auto file = f < keys.files.size() ? keys.files[f].c_str() : otherFile.c_str();
+
+            for (size_t severity = 0; severity < severitiesCount; severity++) {
+                auto record = Record::create(static_cast<Severity>(severity), 0, file, file, "");
+                record.module = module;
+                record.context.reset();
+                record.verbosity.reset();
+                table->decisions.push_back(evaluate(record) ? 1 : 0);
+            }
+        }
+    }
+
+    m_table = std::move(table);
+}
+
+int Chain::dependencies() const
+{
+    int result {};
+
+    for (const auto& x : items())
+        result |= x->dependencies();
+
+    return result;
+}
+
 I::optional_bool Chain_OR::canPass(const Record& record) const
 {
     if (empty()) return m_defaultDecision;
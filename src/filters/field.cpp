@@ -0,0 +1,38 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/filters/field.h>
+#include <string>
+
+namespace ALog {
+namespace Filters {
+
+struct Field::impl_t
+{
+    std::string name;
+    Predicate predicate;
+    bool pass {};
+};
+
+Field::Field(const char* name, const Predicate& predicate, bool pass, Mode mode)
+    : IFilter(mode)
+{
+    createImpl();
+    impl().name = name;
+    impl().predicate = predicate;
+    impl().pass = pass;
+}
+
+Field::~Field() = default;
+
+I::optional_bool Field::canPassImpl(const Record& record) const
+{
+    const auto field = record.findField(impl().name.c_str());
+    if (!field) return {};
+
+    return !(impl().predicate(*field) ^ impl().pass);
+}
+
+} // namespace Filters
+} // namespace ALog
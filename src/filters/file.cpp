@@ -25,6 +25,12 @@ File::~File()
 {
 }
 
+bool File::collectTableKeys(TableKeys& keys) const
+{
+    keys.files.push_back(impl().file);
+    return true;
+}
+
 I::optional_bool File::canPassImpl(const Record& record) const
 {
     return !((impl().file == record.filenameOnly) ^ impl().pass);
@@ -0,0 +1,64 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/filters/hash_sample.h>
+
+namespace ALog {
+namespace Filters {
+
+namespace {
+
+// SplitMix64 finalizer: fixed, platform-independent mixing
+uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Hash values below threshold are kept. rate >= 1 keeps all keys (threshold is inclusive max then)
+uint64_t thresholdOf(double rate)
+{
+    if (!(rate > 0)) return 0;
+    if (rate >= 1) return UINT64_MAX;
+    return static_cast<uint64_t>(rate * 18446744073709551616.0);
+}
+
+bool keepImpl(uint64_t key, uint64_t seed, uint64_t threshold)
+{
+    return threshold == UINT64_MAX || mix(key ^ mix(seed)) < threshold;
+}
+
+} // namespace
+
+struct HashSample::impl_t
+{
+    uint64_t seed {};
+    uint64_t threshold {};
+};
+
+HashSample::HashSample(double rate, uint64_t seed, Mode mode)
+    : IFilter(mode)
+{
+    createImpl();
+    impl().seed = seed;
+    impl().threshold = thresholdOf(rate);
+}
+
+HashSample::~HashSample() = default;
+
+bool HashSample::keep(uint64_t key, double rate, uint64_t seed)
+{
+    return keepImpl(key, seed, thresholdOf(rate));
+}
+
+I::optional_bool HashSample::canPassImpl(const Record& record) const
+{
+    if (!record.sampleKey) return {};
+    return keepImpl(*record.sampleKey, impl().seed, impl().threshold);
+}
+
+} // namespace Filters
+} // namespace ALog
@@ -25,9 +25,16 @@ Module::~Module()
 {
 }
 
+bool Module::collectTableKeys(TableKeys& keys) const
+{
+    keys.modules.push_back(impl().module);
+    return true;
+}
+
 I::optional_bool Module::canPassImpl(const Record& record) const
 {
-    return !((impl().module == record.module) ^ impl().pass);
+    const bool matches = record.module && impl().module == record.module;
+    return !(matches ^ impl().pass);
 }
 
 } // namespace Filters
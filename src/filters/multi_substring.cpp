@@ -0,0 +1,126 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/filters/multi_substring.h>
+#include <cstdint>
+#include <queue>
+
+namespace ALog {
+namespace Filters {
+
+namespace {
+
+constexpr uint32_t matchFlag = 0x80000000u; // Set in transition to state where some pattern ends
+constexpr uint32_t noState = 0xFFFFFFFFu;
+
+uint8_t toLowerAscii(uint8_t c) { return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c + ('a' - 'A')) : c; }
+
+} // namespace
+
+struct MultiSubstring::impl_t
+{
+    uint16_t classes[256] {};          // Byte -> class; 0 for bytes absent in patterns
+    size_t classesCount { 1 };
+    std::vector<uint32_t> transitions; // [state * classesCount + class] -> state | matchFlag
+    bool pass {};
+};
+
+MultiSubstring::MultiSubstring(const std::vector<std::string>& patterns, bool pass, bool caseSensitive, Mode mode)
+    : IFilter(mode)
+{
+    createImpl();
+    impl().pass = pass;
+
+    // Alphabet of pattern bytes only, so the table stays small. Letters of both cases share class if case-insensitive
+    auto& classes = impl().classes;
+    for (const auto& pattern : patterns) {
+        for (const auto x : pattern) {
+            const auto c = caseSensitive ? static_cast<uint8_t>(x) : toLowerAscii(static_cast<uint8_t>(x));
+            if (classes[c]) continue;
+
+            classes[c] = static_cast<uint16_t>(impl().classesCount++);
+            if (!caseSensitive && c >= 'a' && c <= 'z')
+                classes[c - ('a' - 'A')] = classes[c];
+        }
+    }
+
+    const auto classesCount = impl().classesCount;
+
+    // Trie
+    std::vector<uint32_t> children(classesCount, noState);
+    std::vector<uint8_t> terminal(1, 0);
+
+    for (const auto& pattern : patterns) {
+        if (pattern.empty()) continue;
+
+        uint32_t state = 0;
+        for (const auto x : pattern) {
+            const auto index = state * classesCount + classes[static_cast<uint8_t>(x)];
+
+            if (children[index] == noState) {
+                children[index] = static_cast<uint32_t>(terminal.size());
+                terminal.push_back(0);
+                children.resize(children.size() + classesCount, noState);
+            }
+
+            state = children[index];
+        }
+
+        terminal[state] = 1;
+    }
+
+    // Breadth-first: fail links and complete transitions
+    auto& transitions = impl().transitions;
+    transitions.assign(children.size(), 0);
+    std::vector<uint32_t> fail(terminal.size(), 0);
+    std::queue<uint32_t> queue;
+    queue.push(0);
+
+    while (!queue.empty()) {
+        const auto state = queue.front();
+        queue.pop();
+
+        for (size_t c = 0; c < classesCount; c++) {
+            const auto child = children[state * classesCount + c];
+            const auto fallback = state ? transitions[fail[state] * classesCount + c] & ~matchFlag : 0;
+
+            if (child == noState) {
+                transitions[state * classesCount + c] = fallback | (terminal[fallback] ? matchFlag : 0);
+                continue;
+            }
+
+            fail[child] = fallback;
+            terminal[child] |= terminal[fallback];
+            transitions[state * classesCount + c] = child | (terminal[child] ? matchFlag : 0);
+            queue.push(child);
+        }
+    }
+}
+
+MultiSubstring::~MultiSubstring() = default;
+
+bool MultiSubstring::contains(const char* str, size_t len) const
+{
+    const auto& classes = impl().classes;
+    const auto classesCount = impl().classesCount;
+    const auto transitions = impl().transitions.data();
+
+    uint32_t state = 0;
+    for (size_t i = 0; i < len; i++) {
+        const auto next = transitions[state * classesCount + classes[static_cast<uint8_t>(str[i])]];
+        if (next & matchFlag) return true;
+        state = next;
+    }
+
+    return false;
+}
+
+I::optional_bool MultiSubstring::canPassImpl(const Record& record) const
+{
+    const bool contains = this->contains(record.getMessage(), record.getMessageLen());
+    return !(contains ^ impl().pass);
+}
+
+} // namespace Filters
+} // namespace ALog
@@ -0,0 +1,625 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/filters/regex.h>
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ALog {
+namespace Filters {
+
+namespace {
+
+using CharSet = std::bitset<256>;
+
+constexpr uint32_t acceptFlag = 0x80000000u; // Set in transition to accepting state
+constexpr uint32_t noState = 0xFFFFFFFFu;
+constexpr size_t maxRepetitions = 1000;
+constexpr size_t maxNfaStates = 100000;
+constexpr size_t maxDfaStates = 10000;
+
+[[noreturn]] void throwError(const std::string& pattern, const char* reason)
+{
+    throw std::invalid_argument(std::string("ALog::Filters::Regex: ") + reason + " in '" + pattern + "'");
+}
+
+CharSet charRange(unsigned char from, unsigned char to)
+{
+    CharSet result;
+    for (unsigned c = from; c <= to; c++) result.set(c);
+    return result;
+}
+
+CharSet charsOf(const char* chars)
+{
+    CharSet result;
+    for (auto it = chars; *it; ++it) result.set(static_cast<unsigned char>(*it));
+    return result;
+}
+
+CharSet foldCase(CharSet set)
+{
+    for (unsigned c = 'a'; c <= 'z'; c++) {
+        const auto upper = c - ('a' - 'A');
+        if (set[c] || set[upper]) {
+            set.set(c);
+            set.set(upper);
+        }
+    }
+
+    return set;
+}
+
+struct AstNode
+{
+    enum Type { Set, Concat, Alternation, Repeat, Begin, End };
+
+    Type type;
+    CharSet set;
+    std::vector<std::unique_ptr<AstNode>> children;
+    size_t min {};
+    size_t max {};
+    bool unbounded {};
+};
+
+using AstPtr = std::unique_ptr<AstNode>;
+
+AstPtr makeNode(AstNode::Type type)
+{
+    auto result = std::make_unique<AstNode>();
+    result->type = type;
+    return result;
+}
+
+// Recursive descent:
+//   alternation := concat ('|' concat)*
+//   concat      := repeat*
+//   repeat      := atom quantifier*
+class Parser
+{
+public:
+    Parser(const std::string& pattern, bool caseSensitive)
+        : m_pattern(pattern), m_caseSensitive(caseSensitive) { }
+
+    AstPtr parse() {
+        auto result = parseAlternation();
+        if (!atEnd()) throwError(m_pattern, "unmatched ')'");
+        return result;
+    }
+
+private:
+    bool atEnd() const { return m_pos >= m_pattern.size(); }
+    char peek() const { return m_pattern[m_pos]; }
+    char take() { return m_pattern[m_pos++]; }
+
+    AstPtr makeSet(const CharSet& set) const {
+        auto result = makeNode(AstNode::Set);
+        result->set = m_caseSensitive ? set : foldCase(set);
+        return result;
+    }
+
+    AstPtr parseAlternation() {
+        auto first = parseConcat();
+        if (atEnd() || peek() != '|') return first;
+
+        auto result = makeNode(AstNode::Alternation);
+        result->children.push_back(std::move(first));
+
+        while (!atEnd() && peek() == '|') {
+            take();
+            result->children.push_back(parseConcat());
+        }
+
+        return result;
+    }
+
+    AstPtr parseConcat() {
+        auto result = makeNode(AstNode::Concat);
+        while (!atEnd() && peek() != '|' && peek() != ')')
+            result->children.push_back(parseRepeat());
+        return result;
+    }
+
+    AstPtr parseRepeat() {
+        auto atom = parseAtom();
+
+        while (!atEnd()) {
+            auto repeat = makeNode(AstNode::Repeat);
+            const auto c = peek();
+
+            if (c == '*') {
+                take();
+                repeat->unbounded = true;
+            } else if (c == '+') {
+                take();
+                repeat->min = 1;
+                repeat->unbounded = true;
+            } else if (c == '?') {
+                take();
+                repeat->max = 1;
+            } else if (c != '{' || !parseBounds(*repeat)) {
+                break;
+            }
+
+            if (!atEnd() && peek() == '?') take(); // Lazy form finds same matches
+
+            if (atom->type == AstNode::Begin || atom->type == AstNode::End)
+                throwError(m_pattern, "nothing to repeat");
+
+            repeat->children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+
+        return atom;
+    }
+
+    bool parseNumber(size_t& value) {
+        const auto start = m_pos;
+        value = 0;
+
+        while (!atEnd() && peek() >= '0' && peek() <= '9') {
+            value = value * 10 + static_cast<size_t>(take() - '0');
+            if (value > maxRepetitions) throwError(m_pattern, "too many repetitions");
+        }
+
+        return m_pos != start;
+    }
+
+    // {n} {n,} {n,m}; otherwise '{' is literal
+    bool parseBounds(AstNode& repeat) {
+        const auto start = m_pos;
+        take();
+
+        if (!parseNumber(repeat.min)) { m_pos = start; return false; }
+        repeat.max = repeat.min;
+
+        if (!atEnd() && peek() == ',') {
+            take();
+            repeat.unbounded = !parseNumber(repeat.max);
+        }
+
+        if (atEnd() || take() != '}') { m_pos = start; return false; }
+        if (!repeat.unbounded && repeat.max < repeat.min) throwError(m_pattern, "bad repetition range");
+
+        return true;
+    }
+
+    AstPtr parseAtom() {
+        const auto c = take();
+
+        switch (c) {
+            case '(': {
+                if (!atEnd() && peek() == '?') {
+                    if (m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] == ':')
+                        m_pos += 2;
+                    else
+                        throwError(m_pattern, "unsupported group");
+                }
+
+                auto result = parseAlternation();
+                if (atEnd() || take() != ')') throwError(m_pattern, "missing ')'");
+                return result;
+            }
+
+            case '[': {
+                auto result = makeNode(AstNode::Set);
+                result->set = parseClass();
+                return result;
+            }
+
+            case '.': return makeSet(~charsOf("\n"));
+            case '^': return makeNode(AstNode::Begin);
+            case '$': return makeNode(AstNode::End);
+            case '\\': return makeSet(parseEscape(false));
+
+            case '*':
+            case '+':
+            case '?':
+                throwError(m_pattern, "nothing to repeat");
+
+            default:
+                return makeSet(charRange(static_cast<unsigned char>(c), static_cast<unsigned char>(c)));
+        }
+    }
+
+    CharSet parseEscape(bool inClass) {
+        if (atEnd()) throwError(m_pattern, "trailing '\\'");
+
+        static const auto digits = charRange('0', '9');
+        static const auto word = charRange('a', 'z') | charRange('A', 'Z') | digits | charsOf("_");
+        static const auto spaces = charsOf(" \t\n\r\f\v");
+
+        const auto c = take();
+        switch (c) {
+            case 'd': return digits;
+            case 'D': return ~digits;
+            case 'w': return word;
+            case 'W': return ~word;
+            case 's': return spaces;
+            case 'S': return ~spaces;
+            case 't': return charsOf("\t");
+            case 'n': return charsOf("\n");
+            case 'r': return charsOf("\r");
+            case 'f': return charsOf("\f");
+            case 'v': return charsOf("\v");
+            case '0': return charRange(0, 0);
+
+            case 'x': {
+                unsigned value {};
+                for (int i = 0; i < 2; i++) {
+                    const auto x = atEnd() ? '\0' : take();
+                    const auto digit = (x >= '0' && x <= '9') ? x - '0' :
+                                       (x >= 'a' && x <= 'f') ? x - 'a' + 10 :
+                                       (x >= 'A' && x <= 'F') ? x - 'A' + 10 : -1;
+                    if (digit < 0) throwError(m_pattern, "bad '\\x' escape");
+                    value = value * 16 + static_cast<unsigned>(digit);
+                }
+                return charRange(static_cast<unsigned char>(value), static_cast<unsigned char>(value));
+            }
+
+            case 'b':
+                if (inClass) return charsOf("\b");
+                throwError(m_pattern, "word boundaries are not supported");
+
+            default:
+                if ((c >= '1' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+                    throwError(m_pattern, "unsupported escape");
+                return charRange(static_cast<unsigned char>(c), static_cast<unsigned char>(c));
+        }
+    }
+
+    // Returns single character of escape inside class, or -1 for class escapes like \d
+    int parseClassChar(CharSet& set) {
+        const auto c = take();
+        if (c != '\\') return static_cast<unsigned char>(c);
+
+        set = parseEscape(true);
+        if (set.count() != 1) return -1;
+
+        for (int i = 0; i < 256; i++)
+            if (set[static_cast<size_t>(i)]) return i;
+
+        return -1;
+    }
+
+    CharSet parseClass() {
+        CharSet result;
+        const bool negate = !atEnd() && peek() == '^';
+        if (negate) take();
+
+        bool first = true;
+        for (;; first = false) {
+            if (atEnd()) throwError(m_pattern, "missing ']'");
+            if (peek() == ']' && !first) { take(); break; }
+
+            CharSet item;
+            const auto from = parseClassChar(item);
+
+            if (from < 0) {
+                result |= item;
+                continue;
+            }
+
+            // Range, unless '-' is last
+            if (m_pos + 1 < m_pattern.size() && peek() == '-' && m_pattern[m_pos + 1] != ']') {
+                take();
+                const auto to = parseClassChar(item);
+                if (to < from) throwError(m_pattern, "bad class range");
+                result |= charRange(static_cast<unsigned char>(from), static_cast<unsigned char>(to));
+            } else {
+                result.set(static_cast<size_t>(from));
+            }
+        }
+
+        if (!m_caseSensitive) result = foldCase(result);
+        return negate ? ~result : result;
+    }
+
+private:
+    const std::string& m_pattern;
+    bool m_caseSensitive;
+    size_t m_pos {};
+};
+
+struct NfaState
+{
+    enum Type { Set, Epsilon, Begin, End, Match };
+
+    Type type;
+    CharSet set;
+    std::vector<uint32_t> next;
+};
+
+// Thompson construction, each fragment has single entry and exit (without outgoing edges yet)
+class NfaBuilder
+{
+public:
+    struct Fragment {
+        uint32_t start;
+        uint32_t exit;
+    };
+
+    explicit NfaBuilder(const std::string& pattern) : m_pattern(pattern) { }
+
+    uint32_t build(const AstNode& root) {
+        const auto fragment = build(root, 0);
+        link(fragment.exit, add(NfaState::Match));
+        return fragment.start;
+    }
+
+    const std::vector<NfaState>& states() const { return m_states; }
+
+private:
+    uint32_t add(NfaState::Type type, const CharSet& set = {}) {
+        if (m_states.size() >= maxNfaStates) throwError(m_pattern, "pattern is too complex");
+        m_states.push_back({type, set, {}});
+        return static_cast<uint32_t>(m_states.size() - 1);
+    }
+
+    void link(uint32_t from, uint32_t to) { m_states[from].next.push_back(to); }
+
+    Fragment single(NfaState::Type type, const CharSet& set = {}) {
+        const auto start = add(type, set);
+        const auto exit = add(NfaState::Epsilon);
+        link(start, exit);
+        return {start, exit};
+    }
+
+    Fragment build(const AstNode& node, size_t depth) {
+        if (depth > maxRepetitions) throwError(m_pattern, "pattern is too deep");
+
+        switch (node.type) {
+            case AstNode::Set: return single(NfaState::Set, node.set);
+            case AstNode::Begin: return single(NfaState::Begin);
+            case AstNode::End: return single(NfaState::End);
+
+            case AstNode::Concat: {
+                const auto start = add(NfaState::Epsilon);
+                auto exit = start;
+
+                for (const auto& x : node.children) {
+                    const auto fragment = build(*x, depth + 1);
+                    link(exit, fragment.start);
+                    exit = fragment.exit;
+                }
+
+                return {start, exit};
+            }
+
+            case AstNode::Alternation: {
+                const auto start = add(NfaState::Epsilon);
+                const auto exit = add(NfaState::Epsilon);
+
+                for (const auto& x : node.children) {
+                    const auto fragment = build(*x, depth + 1);
+                    link(start, fragment.start);
+                    link(fragment.exit, exit);
+                }
+
+                return {start, exit};
+            }
+
+            case AstNode::Repeat: {
+                const auto& child = *node.children.front();
+                const auto start = add(NfaState::Epsilon);
+                auto current = start;
+
+                for (size_t i = 0; i < node.min; i++) {
+                    const auto fragment = build(child, depth + 1);
+                    link(current, fragment.start);
+                    current = fragment.exit;
+                }
+
+                const auto exit = add(NfaState::Epsilon);
+
+                if (node.unbounded) {
+                    const auto loop = add(NfaState::Epsilon);
+                    const auto fragment = build(child, depth + 1);
+                    link(current, loop);
+                    link(loop, fragment.start);
+                    link(loop, exit);
+                    link(fragment.exit, loop);
+                } else {
+                    for (size_t i = node.min; i < node.max; i++) {
+                        const auto fragment = build(child, depth + 1);
+                        link(current, fragment.start);
+                        link(current, exit);
+                        current = fragment.exit;
+                    }
+
+                    link(current, exit);
+                }
+
+                return {start, exit};
+            }
+        }
+
+        throwError(m_pattern, "internal error");
+    }
+
+private:
+    const std::string& m_pattern;
+    std::vector<NfaState> m_states;
+};
+
+using NfaSet = std::vector<uint32_t>;
+
+// Expands epsilon edges. Keeps states which consume input, wait for end of input or match
+NfaSet closure(const std::vector<NfaState>& states, const NfaSet& from, bool atBegin, bool atEnd)
+{
+    NfaSet result;
+    std::vector<uint8_t> visited(states.size(), 0);
+    std::vector<uint32_t> stack(from.rbegin(), from.rend());
+
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+
+        if (visited[index]) continue;
+        visited[index] = 1;
+
+        const auto& state = states[index];
+        bool follow {};
+
+        switch (state.type) {
+            case NfaState::Set:
+            case NfaState::Match:
+                result.push_back(index);
+                break;
+
+            case NfaState::Epsilon:
+                follow = true;
+                break;
+
+            case NfaState::Begin:
+                follow = atBegin;
+                break;
+
+            case NfaState::End:
+                if (atEnd) follow = true;
+                else result.push_back(index);
+                break;
+        }
+
+        if (follow)
+            for (auto it = state.next.rbegin(); it != state.next.rend(); ++it)
+                stack.push_back(*it);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool hasMatch(const std::vector<NfaState>& states, const NfaSet& set)
+{
+    for (const auto x : set)
+        if (states[x].type == NfaState::Match) return true;
+    return false;
+}
+
+} // namespace
+
+struct Regex::impl_t
+{
+    uint16_t classes[256] {};          // Byte -> class
+    size_t classesCount {};
+    std::vector<uint32_t> transitions; // [state * classesCount + class] -> state | acceptFlag
+    std::vector<uint8_t> acceptAtEnd;  // By state
+    bool acceptAtBegin {};
+    uint32_t deadState { noState };    // No match possible anymore: pattern is anchored by '^' and it failed
+    bool pass {};
+};
+
+Regex::Regex(const char* pattern, bool pass, bool caseSensitive, Mode mode)
+    : IFilter(mode)
+{
+    createImpl();
+    impl().pass = pass;
+
+    const std::string patternStr = pattern ? pattern : "";
+    const auto ast = Parser(patternStr, caseSensitive).parse();
+
+    NfaBuilder builder(patternStr);
+    const auto start = builder.build(*ast);
+    const auto& states = builder.states();
+
+    // Alphabet: bytes are equivalent if all character sets agree on them
+    std::map<std::vector<bool>, uint16_t> signatures;
+    std::vector<unsigned char> representatives;
+
+    for (unsigned c = 0; c < 256; c++) {
+        std::vector<bool> signature;
+        for (const auto& x : states)
+            if (x.type == NfaState::Set) signature.push_back(x.set[c]);
+
+        const auto it = signatures.emplace(std::move(signature), static_cast<uint16_t>(signatures.size())).first;
+        if (it->second == representatives.size()) representatives.push_back(static_cast<unsigned char>(c));
+        impl().classes[c] = it->second;
+    }
+
+    const auto classesCount = representatives.size();
+    impl().classesCount = classesCount;
+
+    // Subset construction. Match may start at any position, so start state is added on each step
+    std::map<NfaSet, uint32_t> ids;
+    std::vector<NfaSet> sets;
+    std::vector<uint8_t> accepting;
+    std::queue<uint32_t> queue;
+
+    auto addState = [&](NfaSet&& set) {
+        const auto it = ids.find(set);
+        if (it != ids.end()) return it->second;
+        if (sets.size() >= maxDfaStates) throwError(patternStr, "pattern is too complex");
+
+        const auto id = static_cast<uint32_t>(sets.size());
+        const bool accept = hasMatch(states, set);
+
+        accepting.push_back(accept);
+        impl().acceptAtEnd.push_back(accept || hasMatch(states, closure(states, set, false, true)));
+        impl().transitions.resize(impl().transitions.size() + classesCount, 0);
+        if (set.empty()) impl().deadState = id;
+
+        ids.emplace(set, id);
+        sets.push_back(std::move(set));
+        if (!accept) queue.push(id); // Scanning stops in accepting state
+        return id;
+    };
+
+    addState(closure(states, {start}, true, false));
+    impl().acceptAtBegin = accepting[0];
+    const auto restart = closure(states, {start}, false, false);
+
+    while (!queue.empty()) {
+        const auto id = queue.front();
+        queue.pop();
+
+        for (size_t c = 0; c < classesCount; c++) {
+            NfaSet moved = restart;
+            for (const auto x : sets[id])
+                if (states[x].type == NfaState::Set && states[x].set[representatives[c]])
+                    moved.push_back(states[x].next.front());
+
+            const auto target = addState(closure(states, moved, false, false));
+            impl().transitions[id * classesCount + c] = target | (accepting[target] ? acceptFlag : 0);
+        }
+    }
+
+}
+
+Regex::~Regex() = default;
+
+bool Regex::matches(const char* str, size_t len) const
+{
+    if (impl().acceptAtBegin) return true;
+
+    const auto& classes = impl().classes;
+    const auto classesCount = impl().classesCount;
+    const auto transitions = impl().transitions.data();
+    const auto deadState = impl().deadState;
+
+    uint32_t state = 0;
+    for (size_t i = 0; i < len; i++) {
+        const auto next = transitions[state * classesCount + classes[static_cast<uint8_t>(str[i])]];
+        if (next & acceptFlag) return true;
+        if (next == deadState) return false;
+        state = next;
+    }
+
+    return impl().acceptAtEnd[state];
+}
+
+I::optional_bool Regex::canPassImpl(const Record& record) const
+{
+    const bool matches = this->matches(record.getMessage(), record.getMessageLen());
+    return !(matches ^ impl().pass);
+}
+
+} // namespace Filters
+} // namespace ALog
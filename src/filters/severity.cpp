@@ -7,10 +7,17 @@
 namespace ALog {
 namespace Filters {
 
+bool Severity::collectTableKeys(TableKeys&) const
+{
+    return true;
+}
+
 I::optional_bool Severity::canPassImpl(const Record& record) const
 {
-    auto ge = record.severity >= m_severity;
-    return (m_comparison == ALog::GreaterEqual) ? ge : !ge;
+    if (m_comparison == ALog::GreaterEqual)
+        return record.reachesSeverity(m_severity);
+
+    return record.severity < m_severity;
 }
 
 } // namespace Filters
@@ -27,11 +27,20 @@ SeverityFile::~SeverityFile()
 {
 }
 
+bool SeverityFile::collectTableKeys(TableKeys& keys) const
+{
+    keys.files.push_back(impl().fileName);
+    return true;
+}
+
 I::optional_bool SeverityFile::canPassImpl(const Record& record) const
 {
     if (impl().fileName != record.filenameOnly) return {};
-    auto ge = record.severity >= impl().severity;
-    return (impl().comparison == ALog::GreaterEqual) ? ge : !ge;
+
+    if (impl().comparison == ALog::GreaterEqual)
+        return record.reachesSeverity(impl().severity);
+
+    return record.severity < impl().severity;
 }
 
 } // namespace Filters
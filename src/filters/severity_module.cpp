@@ -27,11 +27,20 @@ SeverityModule::~SeverityModule()
 {
 }
 
+bool SeverityModule::collectTableKeys(TableKeys& keys) const
+{
+    keys.modules.push_back(impl().module);
+    return true;
+}
+
 I::optional_bool SeverityModule::canPassImpl(const Record& record) const
 {
-    if (impl().module != record.module) return {};
-    auto ge = record.severity >= impl().severity;
-    return (impl().comparison == ALog::GreaterEqual) ? ge : !ge;
+    if (!record.module || impl().module != record.module) return {};
+
+    if (impl().comparison == ALog::GreaterEqual)
+        return record.reachesSeverity(impl().severity);
+
+    return record.severity < impl().severity;
 }
 
 } // namespace Filters
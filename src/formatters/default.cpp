@@ -79,6 +79,27 @@ Buffer Default::format(const Record& record) const
     result.appendString(" ", 1);
     result.appendString(record.getMessage(), record.getMessageLen());
 
+    if (record.context || record.hasFields()) {
+        const char* prefix = " {";
+        const auto appendField = [&result, &prefix](const Record::Field& field){
+            result.appendStringAL(prefix);
+            result.appendStringAL(field.name);
+            result.appendString("=", 1);
+            field.appendValue(result);
+            prefix = ", ";
+        };
+
+        record.forEachContext(appendField);
+        record.forEachField(appendField);
+        result.appendString("}", 1);
+    }
+
+    if (record.suppressed)
+        result.appendFmtString(" (+%llu suppressed)", static_cast<unsigned long long>(record.suppressed));
+
+    if (record.hasFlags(Record::Flags::Backtrace))
+        result.appendString(" (backtrace)");
+
     if (record.hasFlagsAny(Record::Flags::Abort,
                            Record::Flags::Throw))
     {
@@ -0,0 +1,111 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/formatters/json.h>
+#include <alog/tools_internal.h>
+#include <ctime>
+
+namespace ALog {
+namespace Formatters {
+
+namespace {
+
+static const char* const severitiesMap[] = {
+    "Verbose",
+    "Debug",
+    "Info",
+    "Warning",
+    "Error",
+    "Fatal"
+};
+
+void appendKey(I::LongSSO<>& out, const char* key)
+{
+    out.appendString(",\"", 2);
+    out.appendStringAL(key);
+    out.appendString("\":", 2);
+}
+
+void appendStringValue(I::LongSSO<>& out, const char* key, const char* value)
+{
+    if (!value) return;
+    appendKey(out, key);
+    I::appendJsonString(out, value, strlen(value));
+}
+
+} // namespace
+
+Buffer Json::format(const Record& record) const
+{
+    I::LongSSO<> result;
+
+    const auto sinceEpoch = record.systemTp.time_since_epoch();
+    const std::time_t timeT = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count();
+    const auto msecs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000);
+    std::tm tmTime;
+#ifdef _WIN32
+    gmtime_s(&tmTime, &timeT);
+#else
+    (void)gmtime_r(&timeT, &tmTime);
+#endif // _WIN32
+    result.appendFmtString("{\"time\":\"%04d-%02d-%02dT%02d:%02d:%02d.%03dZ\"",
+                           tmTime.tm_year + 1900, tmTime.tm_mon + 1, tmTime.tm_mday,
+                           tmTime.tm_hour, tmTime.tm_min, tmTime.tm_sec, msecs);
+
+    appendStringValue(result, "severity", severitiesMap[record.severity]);
+    appendKey(result, "thread");
+    result.appendFmtString("%d", record.threadNum);
+    appendStringValue(result, "thread_title", record.threadTitle);
+    appendStringValue(result, "module", record.module);
+    appendStringValue(result, "file", record.filenameOnly);
+    appendStringValue(result, "func", record.func);
+    appendKey(result, "line");
+    result.appendFmtString("%d", record.line);
+
+    appendKey(result, "message");
+    I::appendJsonString(result, record.getMessage(), record.getMessageLen());
+
+    char prefix {};
+    const auto appendField = [&result, &prefix](const Record::Field& field){
+        result.appendString(&prefix, 1);
+        I::appendJsonString(result, field.name, strlen(field.name));
+        result.appendString(":", 1);
+        field.appendValue(result);
+        prefix = ',';
+    };
+
+    if (record.context) {
+        appendKey(result, "context");
+        prefix = '{';
+        record.forEachContext(appendField);
+        result.appendString("}", 1);
+    }
+
+    if (record.hasFields()) {
+        appendKey(result, "fields");
+        prefix = '{';
+        record.forEachField(appendField);
+        result.appendString("}", 1);
+    }
+
+    if (record.suppressed) {
+        appendKey(result, "suppressed");
+        result.appendFmtString("%llu", static_cast<unsigned long long>(record.suppressed));
+    }
+
+    if (record.hasFlags(Record::Flags::Backtrace)) {
+        appendKey(result, "backtrace");
+        result.appendString("true");
+    }
+
+    result.appendString("}", 1);
+
+    Buffer resultBuffer(result.getStringLen());
+    memcpy(resultBuffer.data(), result.getString(), result.getStringLen());
+
+    return resultBuffer;
+}
+
+} // namespace Formatters
+} // namespace ALog
@@ -4,12 +4,17 @@
 
 #include <alog/logger_impl.h>
 
+#include <alog/aggregate.h>
+#include <alog/signal_safe.h>
+#include <alog/sites.h>
 #include <alog/formatters/default.h>
 #include <alog/sinks/console.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <condition_variable>
 #include <stdexcept>
@@ -46,16 +51,25 @@ void alog_exception(const char* msg, size_t sz)
 }
 
 
+using Records = std::vector<Record, I::Allocator<Record>>;
+
+namespace {
+std::atomic<uint16_t> loggersCounter {};
+constexpr uint16_t loggerIdMask = 0x7FF;
+constexpr int siteDependencies = IFilter::DependsOnSeverity | IFilter::DependsOnModule | IFilter::DependsOnFile;
+} // namespace
+
 struct Logger::impl_t
 {
     ALog::Sinks::Pipeline pipeline;
 
     LoggerMode mode {};
     std::mutex writeMutex;
+    std::shared_mutex pipelineMutex; // Guards pipeline used by producers against reconfigure()
     std::mutex queueMutex;
     std::thread thread;
     std::condition_variable cv;
-    std::vector<Record> queue;
+    Records queue;
     volatile bool exitFlag {};
     bool threadRunning { false };
 
@@ -64,12 +78,29 @@ struct Logger::impl_t
 
     bool autoflush { false };
 
+    Records backtrace; // Ring
+    size_t backtraceNext {};
+    size_t backtraceCapacity {};
+    Severity backtraceTrigger { Severity::Error };
+
+    std::unique_ptr<I::SignalSlots> signalSlots;
+
+    std::chrono::milliseconds aggregationInterval {};
+    Severity aggregationSeverity { Severity::Info };
+    std::chrono::time_point<std::chrono::steady_clock> aggregationDeadline;
+
+    bool producerFiltering {};
+    uint16_t id {};                         // Distinguishes verdicts cached by sites
+    std::atomic<uint64_t> siteVerdicts {};  // (epoch << 1) | whether filters depend on site attributes only
+
     std::chrono::time_point<std::chrono::steady_clock> startTp = std::chrono::steady_clock::now();
 };
 
 Logger::Logger()
 {
     createImpl();
+    impl().id = loggersCounter.fetch_add(1, std::memory_order_relaxed) & loggerIdMask;
+    I::bumpConfigEpoch();
     setMode(AsynchronousSort);
     setupDefaultConfig();
 }
@@ -78,6 +109,7 @@ Logger::~Logger()
 {
     flush();
     stopThread();
+    I::bumpConfigEpoch();
 }
 
 void Logger::setupDefaultConfig()
@@ -87,23 +119,90 @@ void Logger::setupDefaultConfig()
     impl().pipeline.sinks().set(std::make_shared<ALog::Sinks::Console>());
 }
 
-void Logger::addRecord(Record&& record)
+bool Logger::prepareRecord(Record& record)
 {
+    const bool important = record.hasFlagsAny(Record::Flags::Flush, Record::Flags::Throw, Record::Flags::Abort);
+    const bool early = !important && !impl().backtraceCapacity;
+
+    // Early decision in producer thread: lazy arguments aren't evaluated, sampled out records aren't queued
+    if (record.hasLazyArgs() || record.sampleKey) {
+        if (early) {
+            std::shared_lock<std::shared_mutex> lck(impl().pipelineMutex);
+            if (!impl().pipeline.canPassEarly(record).value_or(true))
+                return false;
+        }
+
+        if (record.hasLazyArgs())
+            record.resolveLazyArgs();
+    }
+
     record.startTp = impl().startTp;
 
     if (record.steadyTp < record.startTp)
         record.steadyTp = record.startTp;
 
+    if (early && impl().producerFiltering) {
+        if (!canPassInProducer(record))
+            return false;
+
+        record.flagsOn(Record::Flags::Internal_Filtered);
+    }
+
     if (impl().autoflush)
         record.flagsOn(Record::Flags::Flush);
 
+    return true;
+}
+
+bool Logger::canPassInProducer(const Record& record)
+{
+    // Records of sites with thread verbosity override or unknown module are decided as usual
+    const bool cacheable = record.site && !record.verbosity && (!record.module || record.moduleId);
+
+    const auto epoch = I::configEpoch();
+    const auto key = (uint64_t(1) << 63) | (uint64_t(epoch) << 31) | (uint64_t(impl().id) << 20) |
+                     (uint64_t(record.moduleId) << 4) | (uint64_t(record.severity) << 1);
+
+    if (cacheable) {
+        const auto cached = record.site->cachedVerdict(key);
+        if (cached.has_value())
+            return *cached;
+    }
+
+    std::shared_lock<std::shared_mutex> lck(impl().pipelineMutex);
+    const bool result = impl().pipeline.canPass(record);
+
+    if (cacheable && siteVerdictsAllowed(epoch))
+        record.site->cacheVerdict(key, result);
+
+    return result;
+}
+
+bool Logger::siteVerdictsAllowed(uint32_t epoch)
+{
+    const auto value = impl().siteVerdicts.load(std::memory_order_relaxed);
+    if ((value >> 1) == epoch)
+        return value & 1;
+
+    const bool result = !(impl().pipeline.filters().dependencies() & ~siteDependencies);
+    impl().siteVerdicts.store((uint64_t(epoch) << 1) | result, std::memory_order_relaxed);
+    return result;
+}
+
+void Logger::addRecord(Record&& record)
+{
+    if (!prepareRecord(record))
+        return;
+
     if (impl().mode == Synchronous) {
         // Sync write
         std::unique_lock<std::mutex> mx(impl().writeMutex);
 
-        bool pass = !record.hasFlags(Record::Flags::Drop);
-        if (pass)
-            impl().pipeline.write({}, record);
+        drainSignalRecords([this](Record& x){ writeRecord(x); });
+        emitAggregatesIfDue([this](Record& x){ writeRecord(x); });
+
+        if (!record.hasFlags(Record::Flags::Drop))
+            writeRecord(record);
 
         if (record.hasFlags(Record::Flags::Flush))
             impl().pipeline.flush();
@@ -150,11 +249,93 @@ void Logger::addRecord(Record&& record)
     }
 }
 
+void Logger::addRecords(Batch&& batch)
+{
+    auto& records = batch.records();
+    auto _clear = I::CreateFinally([&batch](){ batch.clear(); });
+
+    // Rejected records are removed. Records after Throw/Abort one are discarded, like statements following it.
+    size_t count {};
+    bool flush {};
+    const Record* stopRecord {};
+
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!prepareRecord(records[i]))
+            continue;
+
+        if (i != count)
+            records[count] = std::move(records[i]);
+
+        auto& x = records[count++];
+        flush |= x.hasFlags(Record::Flags::Flush);
+
+        if (x.hasFlagsAny(Record::Flags::Throw, Record::Flags::Abort) && !x.hasFlags(Record::Flags::Internal_Queued)) {
+            stopRecord = &x;
+            break;
+        }
+    }
+
+    std::unique_ptr<std::string> throwText;
+    bool abort {};
+
+    if (stopRecord) {
+        abort = stopRecord->hasFlags(Record::Flags::Abort);
+        if (stopRecord->hasFlags(Record::Flags::Throw))
+            throwText = std::make_unique<std::string>(stopRecord->getMessage(), stopRecord->getMessageLen());
+    }
+
+    if (impl().mode == Synchronous) {
+        // Sync write
+        std::unique_lock<std::mutex> mx(impl().writeMutex);
+
+        drainSignalRecords([this](Record& x){ writeRecord(x); });
+        emitAggregatesIfDue([this](Record& x){ writeRecord(x); });
+
+        for (size_t i = 0; i < count; i++) {
+            auto& x = records[i];
+
+            if (!x.hasFlags(Record::Flags::Drop))
+                writeRecord(x);
+
+            if (x.hasFlags(Record::Flags::Flush))
+                impl().pipeline.flush();
+        }
+
+    } else {
+        // Add to queue
+        std::unique_lock<std::mutex> lck(impl().queueMutex);
+
+        for (size_t i = 0; i < count; i++) {
+            auto& x = records[i];
+
+            if (x.hasFlags(Record::Flags::Flush) && !x.steadyTp.time_since_epoch().count())
+                x.steadyTp = decltype(x.steadyTp)::max();
+
+            impl().queue.emplace_back(std::move(x));
+        }
+
+        impl().cv.notify_one();
+
+        if (flush) {
+            impl().flushRequested = true;
+            impl().flushCv.wait(lck, [this](){ return !impl().flushRequested; });
+        }
+    }
+
+    if (abort)
+        alog_abort();
+
+    if (throwText)
+        alog_exception(throwText->c_str(), throwText->size());
+}
+
 void Logger::flush()
 {
     if (impl().mode == Synchronous) {
         // Sync write
         std::lock_guard<std::mutex> lck(impl().writeMutex);
+        drainSignalRecords([this](Record& x){ writeRecord(x); });
+        emitAggregatesIfDue([this](Record& x){ writeRecord(x); });
         impl().pipeline.flush();
     } else {
         // Add to queue & wait
@@ -181,6 +362,128 @@ void Logger::setMode(Logger::LoggerMode mode)
         startThread();
 }
 
+void Logger::setBacktrace(size_t capacity, Severity trigger)
+{
+    const bool async = impl().threadRunning;
+    if (async) stopThread();
+
+    {
+        // Synchronous mode writes under this mutex
+        std::lock_guard<std::mutex> lck(impl().writeMutex);
+        impl().backtrace.clear();
+        impl().backtrace.shrink_to_fit();
+        impl().backtrace.reserve(capacity);
+        impl().backtraceNext = 0;
+        impl().backtraceCapacity = capacity;
+        impl().backtraceTrigger = trigger;
+    }
+
+    if (async) startThread();
+}
+
+#ifdef ALOG_HAS_PMR
+void Logger::setMemoryResource(std::pmr::memory_resource* resource)
+{
+    if (!resource)
+        resource = ALog::memoryResource();
+
+    const bool async = impl().threadRunning;
+    if (async) {
+        flush();
+        stopThread();
+    }
+
+    // Allocator of container can't be replaced by assignment or swap, so containers are recreated
+    const auto recreate = [resource](Records& records){
+        Records backup(std::move(records), resource);
+        records.~Records();
+        new (&records) Records(std::move(backup), resource);
+    };
+
+    recreate(impl().queue);
+    recreate(impl().backtrace);
+    impl().backtrace.reserve(impl().backtraceCapacity);
+
+    if (async)
+        startThread();
+}
+#endif // ALOG_HAS_PMR
+
+bool Logger::addSignalRecord(const SignalRecord& record) noexcept
+{
+    const auto& slots = impl().signalSlots;
+    return slots && slots->push(record);
+}
+
+void Logger::setSignalSlots(size_t count)
+{
+    const bool async = impl().threadRunning;
+    if (async) stopThread();
+
+    impl().signalSlots = count ? std::make_unique<I::SignalSlots>(count) : nullptr;
+
+    if (async) startThread();
+}
+
+uint64_t Logger::droppedSignalRecords() const
+{
+    return impl().signalSlots ? impl().signalSlots->dropped() : 0;
+}
+
+template<typename Func>
+void Logger::drainSignalRecords(const Func& func)
+{
+    if (!impl().signalSlots) return;
+
+    impl().signalSlots->drain([this, &func](const SignalRecord& signalRecord){
+        auto record = signalRecord.toRecord();
+        if (prepareRecord(record))
+            func(record);
+    });
+}
+
+void Logger::setAggregation(std::chrono::milliseconds interval, Severity severity)
+{
+    const bool async = impl().threadRunning;
+    if (async) stopThread();
+
+    impl().aggregationInterval = interval;
+    impl().aggregationSeverity = severity;
+    impl().aggregationDeadline = std::chrono::steady_clock::now() + interval;
+
+    if (async) startThread();
+}
+
+void Logger::emitAggregates()
+{
+    Batch batch;
+    I::AggregateSite::collect(impl().aggregationSeverity, [&batch](Record&& record){ batch += std::move(record); });
+
+    if (!batch.empty())
+        addRecords(std::move(batch));
+}
+
+void Logger::setProducerFiltering(bool value)
+{
+    impl().producerFiltering = value;
+    I::bumpConfigEpoch();
+}
+
+template<typename Func>
+void Logger::emitAggregatesIfDue(const Func& func)
+{
+    if (!impl().aggregationInterval.count()) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now < impl().aggregationDeadline) return;
+    impl().aggregationDeadline = now + impl().aggregationInterval;
+
+    I::AggregateSite::collect(impl().aggregationSeverity, [this, &func](Record&& record){
+        if (prepareRecord(record))
+            func(record);
+    });
+}
+
 Sinks::Pipeline& Logger::pipeline()
 {
     return impl().pipeline;
@@ -191,6 +494,18 @@ const Sinks::Pipeline& Logger::pipeline() const
     return impl().pipeline;
 }
 
+void Logger::reconfigure(Sinks::Pipeline& pipeline)
+{
+    // Consumer writes under 'writeMutex', so records are written by either pipeline as a whole.
+    // Epoch is bumped before producers can see new pipeline, so verdicts of previous one aren't reused.
+    std::lock_guard<std::mutex> writeLck(impl().writeMutex);
+    impl().pipeline.flush();
+
+    std::unique_lock<std::shared_mutex> pipelineLck(impl().pipelineMutex);
+    impl().pipeline.swap(pipeline);
+    I::bumpConfigEpoch();
+}
+
 void Logger::startThread()
 {
     assert(impl().mode != Synchronous);
@@ -219,34 +534,94 @@ void Logger::stopThread()
     impl().queue.clear();
 }
 
+void Logger::writeRecord(Record& record)
+{
+    if (!impl().backtraceCapacity) {
+        if (record.hasFlags(Record::Flags::Internal_Filtered))
+            impl().pipeline.writeUnfiltered({}, record);
+        else
+            impl().pipeline.write({}, record);
+        return;
+    }
+
+    auto& ring = impl().backtrace;
+
+    if (!impl().pipeline.canPass(record)) {
+        // Message of Throw record is still needed by caller
+        Record value = record.hasFlags(Record::Flags::Throw) ? Record(record) : std::move(record);
+
+        if (ring.size() < impl().backtraceCapacity) {
+            ring.emplace_back(std::move(value));
+        } else {
+            ring[impl().backtraceNext] = std::move(value);
+        }
+
+        impl().backtraceNext = (impl().backtraceNext + 1) % impl().backtraceCapacity;
+        return;
+    }
+
+    if (record.severity >= impl().backtraceTrigger && !ring.empty()) {
+        const auto start = (ring.size() < impl().backtraceCapacity) ? 0 : impl().backtraceNext;
+
+        for (size_t i = 0; i < ring.size(); i++) {
+            auto& x = ring[(start + i) % ring.size()];
+            x.flagsOn(Record::Flags::Backtrace);
+            impl().pipeline.writeUnfiltered({}, x);
+        }
+
+        ring.clear();
+        impl().backtraceNext = 0;
+    }
+
+    impl().pipeline.writeUnfiltered({}, record);
+}
+
 void Logger::threadFunc()
 {
-    std::vector<Record> queue;
+    Records queue(impl().queue.get_allocator()); // Same allocator, to be swappable
     bool exitFlag {};
     bool flushRequested {};
 
     while (true) {
         {
             std::unique_lock<std::mutex> lck(impl().queueMutex);
-            impl().cv.wait(lck, [this]() -> bool { return impl().exitFlag || !impl().queue.empty(); });
+            const auto ready = [this]() -> bool { return impl().exitFlag || !impl().queue.empty(); };
+
+            if (impl().signalSlots || impl().aggregationInterval.count()) {
+                // Signal handlers can't notify, so slots are polled
+                auto deadline = impl().signalSlots ? std::chrono::steady_clock::now() + std::chrono::milliseconds(10) : impl().aggregationDeadline;
+                if (impl().aggregationInterval.count() && impl().aggregationDeadline < deadline)
+                    deadline = impl().aggregationDeadline;
+
+                impl().cv.wait_until(lck, deadline, [this, &ready]() -> bool { return ready() || (impl().signalSlots && impl().signalSlots->hasPending()); });
+            } else {
+                impl().cv.wait(lck, ready);
+            }
 
             exitFlag = impl().exitFlag;
             std::swap(queue, impl().queue);
             flushRequested = impl().flushRequested;
         }
 
+        drainSignalRecords([&queue](Record& x){ queue.emplace_back(std::move(x)); });
+        emitAggregatesIfDue([&queue](Record& x){ queue.emplace_back(std::move(x)); });
+
         if (impl().mode == AsynchronousSort) {
             std::stable_sort(queue.begin(), queue.end(), [](const Record& lhs, const Record& rhs) {
                 return lhs.steadyTp < rhs.steadyTp;
             });
         }
 
-        for (const auto& x : queue) {
-            const auto pass = !x.hasFlags(Record::Flags::Drop);
-            if (pass) impl().pipeline.write({}, x);
+        {
+            std::lock_guard<std::mutex> writeLck(impl().writeMutex); // See reconfigure()
 
-            if (x.hasFlags(Record::Flags::Flush))
-                impl().pipeline.flush();
+            for (auto& x : queue) {
+                const auto pass = !x.hasFlags(Record::Flags::Drop);
+                if (pass) writeRecord(x);
+
+                if (x.hasFlags(Record::Flags::Flush))
+                    impl().pipeline.flush();
+            }
         }
 
         queue.clear();
@@ -3,7 +3,10 @@
  * Contact:  ihor-drachuk-libs@pm.me  */
 
 #include <alog/record.h>
+#include <alog/context.h>
+#include <alog/tools_internal.h>
 #include <cwchar>
+#include <cmath>
 
 #ifdef ALOG_HAS_QT_LIBRARY
 #include <QJsonObject>
@@ -34,21 +37,30 @@ constexpr int defaultFlags = defaultFlags_Separators + defaultFlags_Quotes;
 
 namespace ALog {
 
+void Record::init(Severity severity, int line, const char* file, const char* fileOnly, const char* func, int flags)
+{
+    this->severity = severity;
+    this->line = line;
+    this->filenameFull = file;
+    this->filenameOnly = fileOnly;
+    this->func = func;
+    this->threadNum = I::ThreadTools::currentThreadId();
+    this->threadTitle = I::ThreadTools::currentThreadName();
+    this->context = I::currentContext();
+    this->verbosity = I::currentVerbosity();
+    this->module = nullptr;
+    this->moduleId = 0;
+    this->fileId = 0;
+    this->site = nullptr;
+    this->steadyTp = std::chrono::steady_clock::now();
+    this->systemTp = std::chrono::system_clock::now();
+    this->flags = flags;
+    this->skipSeparators = 0;
+}
+
 Record Record::create(Severity severity, int line, const char* file, const char* fileOnly, const char* func) {
     Record record {};
-    record.severity = severity;
-    record.line = line;
-    record.filenameFull = file;
-    record.filenameOnly = fileOnly;
-    record.func = func;
-    record.threadNum = I::ThreadTools::currentThreadId();
-    record.threadTitle = I::ThreadTools::currentThreadName();
-    record.module = nullptr;
-    record.steadyTp = std::chrono::steady_clock::now();
-    record.systemTp = std::chrono::system_clock::now();
-    record.flags = defaultFlags;
-    record.skipSeparators = 0;
-
+    record.init(severity, line, file, fileOnly, func, defaultFlags);
     return record;
 }
 
@@ -59,6 +71,13 @@ Record Record::create(Record::Flags flags)
     return record;
 }
 
+PlainRecord PlainRecord::create(Severity severity, int line, const char* file, const char* fileOnly, const char* func)
+{
+    PlainRecord record {};
+    record.init(severity, line, file, fileOnly, func, 0);
+    return record;
+}
+
 void Record::appendMessage(const wchar_t* msg, size_t len, size_t width, char padding)
 {
     std::mbstate_t state = std::mbstate_t();
@@ -89,28 +108,155 @@ void Record::appendMessage(const wchar_t* msg, size_t len, size_t width, char pa
     appendMessage(tempStr.getString(), tempStr.getStringLen(), width, padding);
 }
 
+void Record::resolveLazyArgs()
+{
+    // Restore statement order
+    const Lazy* ordered {};
+    while (lazyArgs) {
+        const auto next = lazyArgs->next;
+        lazyArgs->next = ordered;
+        ordered = lazyArgs;
+        lazyArgs = next;
+    }
+
+    size_t shift {};
+
+    for (auto it = ordered; it; it = it->next) {
+        Record value;
+        value.severity = severity;
+        value.flags = it->flags;
+        value.separator = separator;
+
+        it->invoke(it->func, value);
+
+        message.insert(it->offset + shift, value.getMessage(), value.getMessageLen());
+        shift += value.getMessageLen();
+
+        if (value.severity > severity)
+            severity = value.severity;
+    }
+}
+
+void Record::Field::appendValue(I::LongSSO<>& out) const
+{
+    char str[32];
+
+    switch (type) {
+        case Type::Integer:
+            out.appendString(str, jeaiii::to_text_from_integer(str, value.i) - str);
+            break;
+
+        case Type::Unsigned:
+            out.appendString(str, jeaiii::to_text_from_integer(str, value.u) - str);
+            break;
+
+        case Type::Double:
+            if (std::isfinite(value.d)) {
+                out.appendFmtString("%.15g", value.d);
+            } else {
+                out.appendString("null");
+            }
+            break;
+
+        case Type::Bool:
+            if (value.b) {
+                out.appendString("true");
+            } else {
+                out.appendString("false");
+            }
+            break;
+
+        case Type::String:
+            I::appendJsonString(out, this->str, strLen);
+            break;
+    }
+}
+
+namespace {
+
+// Streams directly into record message, without own buffer
+class MessageStreamBuf : public std::streambuf
+{
+public:
+    void setTarget(I::LongSSO<>* target) { m_target = target; }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            m_target->push_back(traits_type::to_char_type(ch));
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        m_target->appendString(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    I::LongSSO<>* m_target {};
+};
+
+struct MessageStream
+{
+    MessageStreamBuf buf;
+    std::ostream stream {&buf};
+    bool busy {};
+};
+
+void writeToMessage(MessageStream& ms, I::LongSSO<>& message, const I::OStreamArg& value)
+{
+    ms.buf.setTarget(&message);
+    ms.stream.clear();
+    ms.stream.flags(std::ios_base::dec | std::ios_base::skipws);
+    ms.stream.precision(6);
+    ms.stream.width(0);
+    ms.stream.fill(' ');
+    value.write(ms.stream);
+    ms.buf.setTarget(nullptr);
+}
+
+} // namespace
 
 } // namespace ALog
 
-ALog::Record&& operator<<(ALog::Record&& record, const ALog::Record::RawData& value)
+ALog::Record&& operator<<(ALog::Record&& record, const ALog::I::OStreamArg& value)
 {
-    constexpr size_t strSz = 64;
-    constexpr size_t bufSz = strSz + 1;
-    char str[bufSz];
-    size_t len;
+    record.appendMessage("", 0); // Separator
 
+    static thread_local ALog::MessageStream threadStream;
+
+    if (threadStream.busy) {
+        // Logging from within user's operator<<
+        ALog::MessageStream localStream;
+        ALog::writeToMessage(localStream, record.message, value);
+    } else {
+        threadStream.busy = true;
+        auto _busy = ALog::I::CreateFinally([](){ threadStream.busy = false; });
+        ALog::writeToMessage(threadStream, record.message, value);
+    }
+
+    return std::move(record);
+}
+
+ALog::Record&& operator<<(ALog::Record&& record, const ALog::Record::RawData& value)
+{
     auto _f = ALog::I::CreateFinally([sepBckp = record.separator, &record](){ record.separator = sepBckp; });
     record.separator.clear();
 
+    record.appendMessage("{Buffer; Size: ");
+    record.appendInteger(value.sz);
+    record.appendMessage(", Ptr = ");
+    record.appendPointer(value.ptr);
+
     if (!value.sz) {
-        len = snprintf(str, bufSz, "{Buffer; Size: 0, Ptr = 0x%p. No data}", value.ptr);
-        record.appendMessage(str, len);
+        record.appendMessage(". No data}");
         return std::move(record);
     }
 
-    len = snprintf(str, bufSz, "{Buffer; Size: %zu, Ptr = 0x%p, Data = 0x", value.sz, value.ptr);
-    record.appendMessage(str, len);
+    record.appendMessage(", Data = 0x");
 
+    constexpr size_t strSz = 64;
+    char str[strSz];
     size_t len2 = value.sz;
     const uint8_t* ptr = (const uint8_t*)value.ptr;
 
@@ -118,9 +264,7 @@ ALog::Record&& operator<<(ALog::Record&& record, const ALog::Record::RawData& va
         constexpr size_t printLimit = strSz / 2;
         size_t limit = len2 < printLimit ? len2 : printLimit;
 
-        for (size_t i = 0; i < limit; i++)
-            (void)snprintf(&str[i*2], 3, "%02hhX", *(ptr + i));
-        record.appendMessage(str, limit * 2);
+        record.appendMessage(str, ALog::I::bytesToHex(str, ptr, limit) - str);
 
         len2 -= limit;
         ptr += limit;
@@ -0,0 +1,54 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/signal_safe.h>
+
+namespace ALog {
+
+Record SignalRecord::toRecord() const
+{
+    auto record = Record::create(severity, line, filenameFull, filenameOnly, func);
+    record.module = module;
+    record.threadNum = -1;
+    record.threadTitle = "signal";
+    record.context.reset();
+    record.verbosity.reset();
+    record.steadyTp = steadyTp;
+    record.systemTp = systemTp;
+    record.message.appendString(message, messageLen);
+    return record;
+}
+
+namespace Internal {
+
+SignalSlots::SignalSlots(size_t count)
+    : m_slots(std::make_unique<Slot[]>(count)),
+      m_count(count)
+{
+}
+
+bool SignalSlots::push(const SignalRecord& record) noexcept
+{
+    if (!m_count) return false;
+
+    const auto start = m_next.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < m_count; i++) {
+        auto& slot = m_slots[(start + i) % m_count];
+        uint8_t expected = Free;
+
+        if (slot.state.compare_exchange_strong(expected, Writing, std::memory_order_acquire, std::memory_order_relaxed)) {
+            slot.record = record;
+            m_pending.fetch_add(1, std::memory_order_acq_rel);
+            slot.state.store(Ready, std::memory_order_release);
+            return true;
+        }
+    }
+
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+} // namespace Internal
+} // namespace ALog
@@ -11,8 +11,38 @@ namespace Sinks {
 
 void Chain::write(const Buffer& buffer, const Record& record)
 {
-    for (auto& x : items())
-        x->write(buffer, record);
+    RecordHandle handle;
+
+    for (auto& x : items()) {
+        if (x->acceptsHandles()) {
+            if (!handle)
+                handle = RecordHandle::create(record, buffer);
+
+            x->writeHandle(handle);
+        } else {
+            x->write(buffer, record);
+        }
+    }
+}
+
+bool Chain::acceptsHandles() const
+{
+    for (const auto& x : items())
+        if (x->acceptsHandles())
+            return true;
+
+    return false;
+}
+
+void Chain::writeHandle(const RecordHandle& handle)
+{
+    for (auto& x : items()) {
+        if (x->acceptsHandles()) {
+            x->writeHandle(handle);
+        } else {
+            x->write(handle.buffer(), handle.record());
+        }
+    }
 }
 
 void Chain::flush()
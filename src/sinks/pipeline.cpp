@@ -4,6 +4,8 @@
 
 #include <alog/sinks/pipeline.h>
 
+#include <utility>
+
 namespace ALog {
 namespace Sinks {
 
@@ -33,6 +35,11 @@ void Pipeline::reset()
     impl().sinks.clear();
 }
 
+void Pipeline::swap(Pipeline& other)
+{
+    std::swap(_impl, other._impl);
+}
+
 Filters::Chain& Pipeline::filters()
 {
     return impl().filters;
@@ -53,22 +60,45 @@ Sinks::Chain& Pipeline::sinks()
     return impl().sinks;
 }
 
-void Pipeline::write(const Buffer& buffer, const Record& record)
+I::optional_bool Pipeline::canPassEarly(const Record& record) const
+{
+    if (impl().sinks.empty())
+        return false;
+
+    if (impl().filters.dependencies() & (IFilter::DependsOnMessage | IFilter::DependsOnOther))
+        return {};
+
+    return impl().filters.canPass(record).value_or(true);
+}
+
+bool Pipeline::canPass(const Record& record) const
+{
+    return impl().filters.canPass(record).value_or(true);
+}
+
+void Pipeline::writeUnfiltered(const Buffer& buffer, const Record& record)
 {
     if (impl().sinks.empty())
         return;
 
     assert(buffer.size() || impl().formatter);
 
-    if (impl().filters.canPass(record).value_or(true)) {
-        if (impl().formatter) {
-            impl().sinks.write(impl().converters.convert(impl().formatter->format(record), record), record);
-        } else {
-            impl().sinks.write(impl().converters.convert(buffer, record), record);
-        }
+    if (impl().formatter) {
+        impl().sinks.write(impl().converters.convert(impl().formatter->format(record), record), record);
+    } else {
+        impl().sinks.write(impl().converters.convert(buffer, record), record);
     }
 }
 
+void Pipeline::write(const Buffer& buffer, const Record& record)
+{
+    if (impl().sinks.empty())
+        return;
+
+    if (canPass(record))
+        writeUnfiltered(buffer, record);
+}
+
 void Pipeline::flush()
 {
     impl().sinks.flush();
@@ -0,0 +1,189 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+#include <alog/sites.h>
+
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace ALog {
+
+namespace {
+
+struct Rule {
+    std::string file;
+    std::string func;
+    std::string module;
+    int line {};
+    bool hasFile {};
+    bool hasFunc {};
+    bool hasModule {};
+    SiteState state {};
+};
+
+struct Registry {
+    std::mutex mutex;
+    Internal::Site* sites {}; // Reversed registration order
+    std::vector<Rule> rules;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+bool globMatch(const char* pattern, const char* str)
+{
+    const char* starPattern = nullptr;
+    const char* starStr = nullptr;
+
+    while (*str) {
+        if (*pattern == '*') {
+            starPattern = ++pattern;
+            starStr = str;
+        } else if (*pattern == '?' || *pattern == *str) {
+            ++pattern;
+            ++str;
+        } else if (starPattern) {
+            pattern = starPattern;
+            str = ++starStr;
+        } else {
+            return false;
+        }
+    }
+
+    while (*pattern == '*')
+        ++pattern;
+
+    return !*pattern;
+}
+
+Rule parseQuery(const std::string& query)
+{
+    Rule rule;
+    std::istringstream stream(query);
+    std::string key;
+
+    while (stream >> key) {
+        std::string value;
+        if (!(stream >> value))
+            throw std::invalid_argument("ALog::Sites: missing value for key '" + key + "'");
+
+        if (key == "file") {
+            rule.file = value;
+            rule.hasFile = true;
+        } else if (key == "func") {
+            rule.func = value;
+            rule.hasFunc = true;
+        } else if (key == "module") {
+            rule.module = value;
+            rule.hasModule = true;
+        } else if (key == "line") {
+            try {
+                rule.line = std::stoi(value);
+            } catch (const std::exception&) {
+                throw std::invalid_argument("ALog::Sites: bad line number '" + value + "'");
+            }
+        } else {
+            throw std::invalid_argument("ALog::Sites: unknown key '" + key + "'");
+        }
+    }
+
+    return rule;
+}
+
+bool matches(const Rule& rule, const char* file, int line, const char* func, const char* module)
+{
+    if (rule.line && rule.line != line)
+        return false;
+
+    if (rule.hasFile &&
+        !globMatch(rule.file.c_str(), file) &&
+        !globMatch(rule.file.c_str(), I::extractFileNameOnly(file)))
+        return false;
+
+    if (rule.hasFunc && !globMatch(rule.func.c_str(), func))
+        return false;
+
+    if (rule.hasModule && (!module || !globMatch(rule.module.c_str(), module)))
+        return false;
+
+    return true;
+}
+
+} // namespace
+
+namespace Internal {
+
+Site::State Site::registerSite(const char* func, const char* module)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    const auto current = static_cast<State>(m_state.load(std::memory_order_relaxed));
+    if (current != Unregistered)
+        return current;
+
+    m_func = func;
+    m_module = module;
+    m_fileId = internFile(extractFileNameOnly(m_file));
+    m_next = reg.sites;
+    reg.sites = this;
+
+    auto result = Default;
+    for (const auto& x : reg.rules)
+        if (matches(x, m_file, m_line, m_func, m_module))
+            result = static_cast<State>(x.state);
+
+    m_state.store(result, std::memory_order_release);
+    return result;
+}
+
+} // namespace Internal
+
+std::vector<Sites::Info> Sites::list()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    std::vector<Info> result;
+    for (auto it = reg.sites; it; it = it->m_next)
+        result.push_back({it->m_file, it->m_line, it->m_func, it->m_module, static_cast<SiteState>(it->m_state.load(std::memory_order_relaxed))});
+
+    return {result.rbegin(), result.rend()};
+}
+
+size_t Sites::set(const std::string& query, SiteState state)
+{
+    auto rule = parseQuery(query);
+    rule.state = state;
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    size_t count {};
+    for (auto it = reg.sites; it; it = it->m_next) {
+        if (matches(rule, it->m_file, it->m_line, it->m_func, it->m_module)) {
+            it->m_state.store(static_cast<int>(state), std::memory_order_release);
+            count++;
+        }
+    }
+
+    reg.rules.emplace_back(std::move(rule));
+    return count;
+}
+
+void Sites::reset()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lck(reg.mutex);
+
+    reg.rules.clear();
+    for (auto it = reg.sites; it; it = it->m_next)
+        it->m_state.store(Internal::Site::Default, std::memory_order_release);
+}
+
+} // namespace ALog
@@ -8,12 +8,34 @@
 
 #include <atomic>
 #include <cassert>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #ifdef ALOG_HAS_QT_LIBRARY
 #include <QString>
 #endif // ALOG_HAS_QT_LIBRARY
 
 namespace ALog {
+
+#ifdef ALOG_HAS_PMR
+namespace {
+std::atomic<std::pmr::memory_resource*> currentMemoryResource {nullptr};
+} // namespace
+
+void setMemoryResource(std::pmr::memory_resource* resource)
+{
+    currentMemoryResource.store(resource, std::memory_order_release);
+}
+
+std::pmr::memory_resource* memoryResource()
+{
+    const auto result = currentMemoryResource.load(std::memory_order_acquire);
+    return result ? result : std::pmr::new_delete_resource();
+}
+#endif // ALOG_HAS_PMR
+
 namespace Internal {
 
 namespace ThreadTools {
@@ -47,6 +69,54 @@ const char* currentThreadName()
 
 } // namespace ThreadTools
 
+namespace {
+
+class InternTable
+{
+public:
+    uint16_t intern(const char* name) {
+        if (!name) return 0;
+
+        std::lock_guard<std::mutex> lck(m_mutex);
+
+        const auto it = m_ids.find(name);
+        if (it != m_ids.end()) return it->second;
+        if (m_ids.size() >= std::numeric_limits<uint16_t>::max()) return 0;
+
+        const auto id = static_cast<uint16_t>(m_ids.size() + 1);
+        m_ids.emplace(name, id);
+        return id;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, uint16_t> m_ids;
+};
+
+InternTable& modulesTable()
+{
+    static InternTable instance;
+    return instance;
+}
+
+InternTable& filesTable()
+{
+    static InternTable instance;
+    return instance;
+}
+
+} // namespace
+
+uint16_t internModule(const char* name) { return modulesTable().intern(name); }
+uint16_t internFile(const char* name) { return filesTable().intern(name); }
+
+namespace {
+std::atomic<uint32_t> currentConfigEpoch {1};
+} // namespace
+
+uint32_t configEpoch() { return currentConfigEpoch.load(std::memory_order_acquire); }
+void bumpConfigEpoch() { currentConfigEpoch.fetch_add(1, std::memory_order_acq_rel); }
+
 bool isSeparatorSymbol(char c)
 {
     static bool isSeparator[256] {false};
@@ -124,5 +124,38 @@ const std::string& getResetColorCode()
     return code;
 }
 
+void appendJsonString(LongSSO<>& out, const char* str, size_t len)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    out.appendString("\"", 1);
+
+    const char* chunk = str;
+    const char* const end = str + len;
+
+    for (auto it = str; it != end; ++it) {
+        const auto c = static_cast<unsigned char>(*it);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.appendString(chunk, it - chunk);
+        chunk = it + 1;
+
+        switch (c) {
+            case '"':  out.appendString("\\\"", 2); break;
+            case '\\': out.appendString("\\\\", 2); break;
+            case '\n': out.appendString("\\n", 2); break;
+            case '\r': out.appendString("\\r", 2); break;
+            case '\t': out.appendString("\\t", 2); break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+                out.appendString(escaped, sizeof(escaped));
+            }
+        }
+    }
+
+    out.appendString(chunk, end - chunk);
+    out.appendString("\"", 1);
+}
+
 } // namespace Internal
 } // namespace ALog
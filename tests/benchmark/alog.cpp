@@ -6,6 +6,9 @@
 #include <alog/logger.h>
 #include <alog/formatters/minimal.h>
 #include <alog/containers/all.h>
+#include <alog/filters/all.h>
+#include <regex>
+#include <sstream>
 
 static void LogMessage_module(benchmark::State& state)
 {
@@ -60,6 +63,36 @@ static void LogMessage_main_sync(benchmark::State& state)
 BENCHMARK(LogMessage_main_sync);
 
 
+static void logRejected(benchmark::State& state, bool producerFiltering)
+{
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::AsynchronousSort);
+    ALOGGER_DIRECT->setProducerFiltering(producerFiltering);
+    ALOGGER_DIRECT->pipeline().sinks().set(std::make_shared<ALog::Sinks::Functor2>([](const ALog::Buffer&, const ALog::Record&){}));
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    while (state.KeepRunning())
+        LOGD << "Rejected" << 123;
+}
+
+static void LogMessage_rejected_consumer(benchmark::State& state)
+{
+    logRejected(state, false);
+}
+
+BENCHMARK(LogMessage_rejected_consumer);
+
+
+static void LogMessage_rejected_producer(benchmark::State& state)
+{
+    logRejected(state, true);
+}
+
+BENCHMARK(LogMessage_rejected_producer);
+
+
 static void LogMessage_complex(benchmark::State& state)
 {
     DEFINE_ALOGGER_MODULE(ALogTest);
@@ -111,4 +144,260 @@ static void LogMessage_sink_sync(benchmark::State& state)
 
 BENCHMARK(LogMessage_sink_sync);
 
+static void LogMessage_x10_async(benchmark::State& state)
+{
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+    ALOGGER_DIRECT->pipeline().reset();
+    ALOGGER_DIRECT->pipeline().sinks().set(std::make_shared<ALog::Sinks::Null>());
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    while (state.KeepRunning())
+        for (int i = 0; i < 10; i++)
+            LOGD << i;
+}
+
+BENCHMARK(LogMessage_x10_async);
+
+
+static void LogMessage_x10_batch_async(benchmark::State& state)
+{
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+    ALOGGER_DIRECT->pipeline().reset();
+    ALOGGER_DIRECT->pipeline().sinks().set(std::make_shared<ALog::Sinks::Null>());
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+
+    DEFINE_ALOGGER_MODULE(ALogTest);
+    ALog::Batch batch(10);
+
+    while (state.KeepRunning()) {
+        for (int i = 0; i < 10; i++)
+            ALOG_BATCH(batch, ALog::Severity::Debug) << i;
+        ACCESS_ALOGGER_MODULE += std::move(batch);
+    }
+}
+
+BENCHMARK(LogMessage_x10_batch_async);
+
+
+static void Record_build_dynamic(benchmark::State& state)
+{
+    const std::string str = "value";
+
+    while (state.KeepRunning()) {
+        auto record = ALOG_RECORD_POLICY_IMPL(ALog::RecordPolicy::Dynamic, ALog::Severity::Debug) << "Key: " << str << ", id: " << 12345 << ", ok: " << true;
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_build_dynamic);
+
+
+static void Record_build_plain(benchmark::State& state)
+{
+    const std::string str = "value";
+
+    while (state.KeepRunning()) {
+        auto record = ALOG_RECORD_POLICY_IMPL(ALog::RecordPolicy::Plain, ALog::Severity::Debug) << "Key: " << str << ", id: " << 12345 << ", ok: " << true;
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_build_plain);
+
+static void Record_build_regular(benchmark::State& state)
+{
+    const std::string str = "value";
+
+    while (state.KeepRunning()) {
+        auto record = ALOG_RECORD_IMPL(ALog::Severity::Debug) << "Order" << str << "filled at" << 12345 << "with status" << true;
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_build_regular);
+
+
+static void Record_build_prepared(benchmark::State& state)
+{
+    const std::string str = "value";
+    static const auto stmt = ALOG_PREPARE(Debug, "Order", _, "filled at", _, "with status", _);
+
+    while (state.KeepRunning()) {
+        auto record = stmt.at(__LINE__, __FILE__, "alog.cpp", __func__).record(str, 12345, true);
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_build_prepared);
+
+
+static void Aggregate_add(benchmark::State& state)
+{
+    DEFINE_ALOGGER_MODULE(ALogTest);
+    int value = 0;
+
+    while (state.KeepRunning())
+        LOG_AGGREGATE("value", value++ & 1023);
+}
+
+BENCHMARK(Aggregate_add)->Threads(1)->Threads(4);
+
+
+namespace {
+struct Point { int x; int y; };
+std::ostream& operator<<(std::ostream& os, const Point& value) { return os << "Point(" << value.x << ", " << value.y << ")"; }
+} // namespace
+
+static void Record_ostream_string(benchmark::State& state)
+{
+    const Point point {12, 34};
+
+    while (state.KeepRunning()) {
+        std::ostringstream os;
+        os << point;
+        auto record = ALOG_RECORD_IMPL(ALog::Severity::Debug) << "Point: " << os.str();
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_ostream_string);
+
+
+static void Record_ostream_bridge(benchmark::State& state)
+{
+    const Point point {12, 34};
+
+    while (state.KeepRunning()) {
+        auto record = ALOG_RECORD_IMPL(ALog::Severity::Debug) << "Point: " << point;
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(Record_ostream_bridge);
+
+namespace {
+std::shared_ptr<ALog::Filters::Chain> createModulesChain(bool compilable)
+{
+    static const char* modules[] = {"module0", "module1", "module2", "module3", "module4", "module5", "module6", "module7"};
+
+    auto result = ALog::Filters::Chain::create();
+    for (auto module : modules)
+        result->add<ALog::Filters::SeverityModule>(ALog::Severity::Warning, module, ALog::IFilter::PassOrUndefined);
+    result->add<ALog::Filters::Severity>(ALog::Severity::Info);
+
+    if (!compilable)
+        result->add<ALog::Filters::Functor2>([](const ALog::Record&) -> ALog::I::optional_bool { return {}; });
+
+    return result;
+}
+
+void filterChain(benchmark::State& state, bool compilable)
+{
+    const auto chain = createModulesChain(compilable);
+    auto record = ALOG_RECORD_IMPL(ALog::Severity::Debug);
+    record.module = "module7";
+    record.moduleId = ALog::I::internModule(record.module);
+    record.fileId = ALog::I::internFile(record.filenameOnly);
+    record.verbosity.reset();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(chain->canPass(record));
+}
+} // namespace
+
+static void Filter_chain_regular(benchmark::State& state)
+{
+    filterChain(state, false);
+}
+
+BENCHMARK(Filter_chain_regular);
+
+
+static void Filter_chain_compiled(benchmark::State& state)
+{
+    filterChain(state, true);
+}
+
+BENCHMARK(Filter_chain_compiled);
+
+static std::vector<std::string> substringPatterns()
+{
+    std::vector<std::string> result;
+    for (int i = 0; i < 32; i++)
+        result.push_back("pattern-" + std::to_string(i));
+    return result;
+}
+
+static ALog::Record substringRecord()
+{
+    return ALOG_RECORD_IMPL(ALog::Severity::Debug) << "Connection to server established, waiting for handshake response from remote peer";
+}
+
+static void Filter_substring_chain(benchmark::State& state)
+{
+    auto chain = ALog::Filters::Chain::create();
+    for (const auto& x : substringPatterns())
+        chain->add<ALog::Filters::Substring>(x.c_str(), false, false, ALog::IFilter::RejectOrUndefined);
+
+    const auto record = substringRecord();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(chain->canPass(record));
+}
+
+BENCHMARK(Filter_substring_chain);
+
+
+static void Filter_multi_substring(benchmark::State& state)
+{
+    const ALog::Filters::MultiSubstring filter(substringPatterns(), false, false);
+    const auto record = substringRecord();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(filter.canPass(record));
+}
+
+BENCHMARK(Filter_multi_substring);
+
+static void Filter_regex_std(benchmark::State& state)
+{
+    const std::regex regex("timeout|refused|error [0-9]+");
+    const auto record = substringRecord();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(std::regex_search(record.getMessage(), record.getMessage() + record.getMessageLen(), regex));
+}
+
+BENCHMARK(Filter_regex_std);
+
+
+static void Filter_regex(benchmark::State& state)
+{
+    const ALog::Filters::Regex filter("timeout|refused|error [0-9]+");
+    const auto record = substringRecord();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(filter.canPass(record));
+}
+
+BENCHMARK(Filter_regex);
+
+
+static void Filter_substring(benchmark::State& state)
+{
+    const ALog::Filters::Substring filter("timeout");
+    const auto record = substringRecord();
+
+    while (state.KeepRunning())
+        benchmark::DoNotOptimize(filter.canPass(record));
+}
+
+BENCHMARK(Filter_substring);
+
 BENCHMARK_MAIN();
@@ -395,4 +395,64 @@ static void IntToStr_jeaiii(benchmark::State& state)
 
 BENCHMARK(IntToStr_jeaiii);
 
+static void IntToHex_snprintf(benchmark::State& state)
+{
+    uint64_t value = 0x1234ABCD5678EF;
+
+    while (state.KeepRunning()) {
+        char buffer[2 + 16 + 1];
+        snprintf(buffer, sizeof(buffer), "0x%" PRIX64, value++);
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+
+BENCHMARK(IntToHex_snprintf);
+
+
+static void IntToHex_table(benchmark::State& state)
+{
+    uint64_t value = 0x1234ABCD5678EF;
+
+    while (state.KeepRunning()) {
+        char buffer[2 + 16];
+        char* begin = ALog::I::toHexReversed(buffer + sizeof(buffer), value++);
+        *--begin = 'x';
+        *--begin = '0';
+        benchmark::DoNotOptimize(begin);
+    }
+}
+
+BENCHMARK(IntToHex_table);
+
+
+static void BytesToHex_snprintf(benchmark::State& state)
+{
+    uint8_t data[32];
+    std::iota(std::begin(data), std::end(data), 0);
+
+    while (state.KeepRunning()) {
+        char buffer[sizeof(data) * 2 + 1];
+        for (size_t i = 0; i < sizeof(data); i++)
+            (void)snprintf(&buffer[i*2], 3, "%02hhX", data[i]);
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+
+BENCHMARK(BytesToHex_snprintf);
+
+
+static void BytesToHex_table(benchmark::State& state)
+{
+    uint8_t data[32];
+    std::iota(std::begin(data), std::end(data), 0);
+
+    while (state.KeepRunning()) {
+        char buffer[sizeof(data) * 2];
+        benchmark::DoNotOptimize(ALog::I::bytesToHex(buffer, data, sizeof(data)));
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+
+BENCHMARK(BytesToHex_table);
+
 BENCHMARK_MAIN();
@@ -6,10 +6,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <csignal>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <fstream>
 #include <numeric>
 #include <regex>
 #include <stdexcept>
@@ -22,6 +25,7 @@
 #include <map>
 #include <unordered_map>
 #include <utility>
+#include <type_traits>
 
 #ifdef ALOG_HAS_QT_LIBRARY
 #include <QMetaType>
@@ -580,13 +584,94 @@ TEST(ALog, test_hex)
     const uint8_t buffer[] = {1, 2, 3, 4, 5, 6};
     char buffer2[1024];
 
+    const auto ptrValue = static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(buffer));
+
     auto record = ALOG_RECORD_IMPL(ALog::Severity::Info) << BUFFER(buffer, sizeof(buffer));
-    snprintf(buffer2, sizeof(buffer2), "{Buffer; Size: 6, Ptr = 0x%p, Data = 0x010203040506}", buffer);
+    snprintf(buffer2, sizeof(buffer2), "{Buffer; Size: 6, Ptr = 0x%llX, Data = 0x010203040506}", ptrValue);
     EXPECT_STREQ(record.getMessage(), buffer2);
 
     record = ALOG_RECORD_IMPL(ALog::Severity::Info) << BUFFER(buffer, 0);
-    snprintf(buffer2, sizeof(buffer2), "{Buffer; Size: 0, Ptr = 0x%p. No data}", buffer);
+    snprintf(buffer2, sizeof(buffer2), "{Buffer; Size: 0, Ptr = 0x%llX. No data}", ptrValue);
     EXPECT_STREQ(record.getMessage(), buffer2);
+
+    std::vector<uint8_t> bigBuffer(100);
+    std::string expected;
+    for (size_t i = 0; i < bigBuffer.size(); i++) {
+        bigBuffer[i] = static_cast<uint8_t>(i * 7);
+        snprintf(buffer2, sizeof(buffer2), "%02X", bigBuffer[i]);
+        expected += buffer2;
+    }
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << BUFFER(bigBuffer.data(), bigBuffer.size());
+    EXPECT_NE(strstr(record.getMessage(), ("Data = 0x" + expected + "}").c_str()), nullptr);
+}
+
+TEST(ALog, test_hex_manipulators)
+{
+    char buffer[64];
+
+    auto record = ALOG_RECORD_IMPL(ALog::Severity::Info) << HEX(0) << " " << HEX(255) << " " << HEX(0xABCu, 8) << " " << HEX(-1) << " " << HEX((int8_t)-2);
+    EXPECT_STREQ(record.getMessage(), "0x0 0xFF 0x00000ABC 0xFFFFFFFF 0xFE");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << HEX(UINT64_MAX) << " " << HEX(1, 100) << " " << HEX(0x1234, 2);
+    EXPECT_STREQ(record.getMessage(), "0xFFFFFFFFFFFFFFFF 0x0000000000000001 0x1234");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << BIN((uint8_t)5) << " " << BIN((int16_t)-1) << " " << BIN(0x80000001u);
+    EXPECT_STREQ(record.getMessage(), "0b00000101 0b1111111111111111 0b10000000000000000000000000000001");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << PTR(nullptr);
+    EXPECT_STREQ(record.getMessage(), "0x0");
+
+    const int value = 0;
+    snprintf(buffer, sizeof(buffer), "0x%llX", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(&value)));
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << PTR(&value);
+    EXPECT_STREQ(record.getMessage(), buffer);
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << static_cast<const void*>(&value);
+    EXPECT_STREQ(record.getMessage(), buffer);
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << NSEPS << &value;
+    EXPECT_STREQ(record.getMessage(), (std::string("(") + typeid(int).name() + "*)" + buffer).c_str());
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << SEPS << "Id:" << HEX(0x2A, 4) << "mask:" << BIN((uint8_t)3);
+    EXPECT_STREQ(record.getMessage(), "Id: 0x002A mask: 0b00000011");
+}
+
+TEST(ALog, test_plain_policy)
+{
+    using Plain = ALog::RecordPolicy::Plain;
+
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& record){
+        records.push_back(record);
+    });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    static_assert(std::is_same_v<decltype(ALOG_RECORD_POLICY_IMPL(Plain, ALog::Severity::Info) << "a" << 1 << std::string() << FLUSH), ALog::PlainRecord&&>);
+
+    const std::string str = "str";
+    const char* cstr = "cstr";
+
+    ACCESS_ALOGGER_MODULE += ALOG_RECORD_POLICY_IMPL(Plain, ALog::Severity::Info) << "a" << 1 << ' ' << str << cstr << true << (uint8_t)7 << -5ll << std::string_view("|");
+    ACCESS_ALOGGER_MODULE += ALOG_RECORD_POLICY_IMPL(Plain, ALog::Severity::Warning) << "v=" << std::vector<int>{1, 2} << "," << str << 2.5;
+    ACCESS_ALOGGER_MODULE += ALOG_RECORD_POLICY_IMPL(Plain, ALog::Severity::Info).seps() << "a" << str;
+    ACCESS_ALOGGER_MODULE += ALOG_RECORD_POLICY_IMPL(Plain, ALog::Severity::Info).seps().quotes() << "a" << str;
+
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_STREQ(records[0].getMessage(), "a1 strcstrtrue7-5|");
+    EXPECT_STREQ(records[0].module, "ALogTest");
+    EXPECT_EQ(records[1].severity, ALog::Severity::Warning);
+    const auto dynamic = ALOG_RECORD_IMPL(ALog::Severity::Info).no_seps().no_quotes() << "v=" << std::vector<int>{1, 2} << "," << str << 2.5;
+    EXPECT_STREQ(records[1].getMessage(), dynamic.getMessage());
+    EXPECT_STREQ(records[2].getMessage(), "a str");
+    EXPECT_STREQ(records[3].getMessage(), "a \"str\"");
 }
 
 TEST(ALog, test_flags)
@@ -804,6 +889,65 @@ TEST(ALog, test_filters_substring_pass_mode)
     EXPECT_EQ(items.count("This is regular info"), 0);
 }
 
+TEST(ALog, test_filters_multi_substring)
+{
+    const std::vector<std::string> patterns {"he", "she", "his", "hers", "abcabd", "bca", "", "X-Y"};
+
+    auto naive = [&patterns](const std::string& str, bool caseSensitive) {
+        auto lower = [](std::string value) {
+            for (auto& c : value) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return value;
+        };
+
+        const auto haystack = caseSensitive ? str : lower(str);
+        for (const auto& x : patterns)
+            if (!x.empty() && haystack.find(caseSensitive ? x : lower(x)) != std::string::npos)
+                return true;
+        return false;
+    };
+
+    ALog::Filters::MultiSubstring sensitive(patterns);
+    ALog::Filters::MultiSubstring insensitive(patterns, true, false);
+
+    // Random strings over small alphabet cover overlaps and fail links
+    const char alphabet[] = "abcdehirsxyABCDEHIRSXY-";
+    uint32_t seed = 12345;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+    for (int i = 0; i < 5000; i++) {
+        std::string str(next() % 12, ' ');
+        for (auto& c : str) c = alphabet[next() % (sizeof(alphabet) - 1)];
+
+        EXPECT_EQ(sensitive.contains(str.data(), str.size()), naive(str, true)) << str;
+        EXPECT_EQ(insensitive.contains(str.data(), str.size()), naive(str, false)) << str;
+    }
+
+    EXPECT_TRUE(sensitive.contains("abcabcabd", 9));
+    EXPECT_FALSE(sensitive.contains("SHE", 3));
+    EXPECT_TRUE(insensitive.contains("SHE", 3));
+    EXPECT_FALSE(ALog::Filters::MultiSubstring({}).contains("anything", 8));
+
+    // Through logger
+    std::vector<std::string> records;
+
+    DEFINE_MAIN_ALOGGER;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec.getMessage()); });
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::MultiSubstring>(
+        std::vector<std::string>{"password", "token"}, false, false));
+    ALOGGER_DIRECT->setMode(ALog::Logger::LoggerMode::Synchronous);
+    MARK_ALOGGER_READY;
+
+    DEFINE_ALOGGER_MODULE(SubstringTest);
+
+    LOGD << "User logged in";
+    LOGD << "Password:" << "secret";
+    LOGD << "Refresh" << "TOKEN" << 42;
+    LOGD << "Done";
+
+    EXPECT_EQ(records, (std::vector<std::string>{"User logged in", "Done"}));
+}
+
 TEST(ALog, test_separators_advanced)
 {
 #if 0
@@ -1216,6 +1360,1342 @@ TEST(ALog, test_smart_pointers)
     EXPECT_STREQ(records[3].getMessage(), R"(std::unique_ptr(std::chrono::duration(25 ms)))");
 }
 
+TEST(ALog, test_sampling)
+{
+    using namespace std::literals::chrono_literals;
+
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    for (int i = 0; i < 10; i++)
+        LOGI_EVERY_N(3) << "EveryN" << i;
+
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_STREQ(records[0].getMessage(), "EveryN0");
+    EXPECT_STREQ(records[3].getMessage(), "EveryN9");
+    EXPECT_EQ(records[0].suppressed, 0);
+    EXPECT_EQ(records[1].suppressed, 2);
+    EXPECT_EQ(records[3].suppressed, 2);
+    records.clear();
+
+    for (int i = 0; i < 5; i++)
+        LOGMW_FIRST_N(2) << "FirstN" << i;
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "FirstN0");
+    EXPECT_STREQ(records[1].getMessage(), "FirstN1");
+    EXPECT_EQ(records[1].suppressed, 0);
+    records.clear();
+
+    auto logEveryMs = [&](int i) { LOGD_EVERY_MS(50) << "EveryMs" << i; };
+
+    logEveryMs(0);
+    logEveryMs(1);
+    logEveryMs(2);
+    std::this_thread::sleep_for(60ms);
+    logEveryMs(3);
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "EveryMs0");
+    EXPECT_STREQ(records[1].getMessage(), "EveryMs3");
+    EXPECT_EQ(records[0].suppressed, 0);
+    EXPECT_EQ(records[1].suppressed, 2);
+
+    int evaluated = 0;
+    for (int i = 0; i < 4; i++)
+        LOGI_EVERY_N(2) << ++evaluated;
+    EXPECT_EQ(evaluated, 2);
+}
+
+TEST(ALog, test_fields)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Field>("latency_us", [](const ALog::Record::Field& f){ return f.value.i < 1000; }, false, ALog::IFilter::RejectOrUndefined));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    const std::string path = "a\"b";
+    LOGI << "Request" << FIELD("latency_us", 1500) << FIELD("ok", true) << FIELD("path", path) << FIELD("ratio", 0.5) << FIELD("size", 7u) << "done";
+    LOGI << "Fast" << FIELD("latency_us", 10);
+    LOGI << "Plain";
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "Requestdone");
+    EXPECT_STREQ(records[1].getMessage(), "Plain");
+    EXPECT_FALSE(records[1].hasFields());
+
+    const auto& record = records[0];
+    ASSERT_TRUE(record.findField("latency_us"));
+    EXPECT_EQ(record.findField("latency_us")->type, ALog::Record::Field::Type::Integer);
+    EXPECT_EQ(record.findField("latency_us")->value.i, 1500);
+    EXPECT_EQ(record.findField("size")->type, ALog::Record::Field::Type::Unsigned);
+    EXPECT_EQ(record.findField("path")->type, ALog::Record::Field::Type::String);
+    EXPECT_EQ(std::string(record.findField("path")->str, record.findField("path")->strLen), path);
+    EXPECT_FALSE(record.findField("missing"));
+
+    std::vector<std::string> names;
+    record.forEachField([&names](const ALog::Record::Field& f){ names.emplace_back(f.name); });
+    EXPECT_EQ(names, (std::vector<std::string>{"latency_us", "ok", "path", "ratio", "size"}));
+
+    const auto toString = [](const ALog::Buffer& buffer) { return std::string(buffer.begin(), buffer.end()); };
+
+    const auto text = toString(ALog::Formatters::Default().format(record));
+    EXPECT_NE(text.find(R"(Requestdone {latency_us=1500, ok=true, path="a\"b", ratio=0.5, size=7})"), std::string::npos) << text;
+
+    const auto json = toString(ALog::Formatters::Json().format(record));
+    EXPECT_TRUE(regexMatch(json, R"(\{"time":"[0-9T:.-]+Z","severity":"Info","thread":\d+,"module":"ALogTest","file":"test3_alog.cpp","func":"TestBody","line":\d+,)"
+                                 R"("message":"Requestdone","fields":\{"latency_us":1500,"ok":true,"path":"a\\"b","ratio":0.5,"size":7\}\})")) << json;
+}
+
+TEST(ALog, test_lazy)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set({sink, sink});
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    int calls = 0;
+    auto dump = [&calls]() { calls++; return std::vector<int>{1, 2}; };
+
+    LOGD << "Dropped" << LAZY(dump);
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(records.empty());
+
+    LOGI << "State:" << LAZY(dump) << "; id:" << LAZY([]{ return 5; });
+    EXPECT_EQ(calls, 1);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "State:{Container; Size: 2; Data = 1, 2}; id:5");
+    records.clear();
+
+    LOGI.seps() << "A" << LAZY([]{ return std::string("B"); }) << "C";
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), R"(A "B" C)");
+    records.clear();
+
+    // Message-dependent filters require evaluation
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Substring>("skip", false));
+    LOGI << "Keep" << LAZY(dump);
+    LOGI << "Skip" << LAZY([]{ return "skip"; });
+    EXPECT_EQ(calls, 2);
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "Keep{Container; Size: 2; Data = 1, 2}");
+
+    // Disabled statements don't evaluate anything
+    LOGMD_IF(false) << LAZY(dump);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(ALog, test_context)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::AsynchronousSort);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    LOGI << "Before";
+
+    {
+        std::string user = "bob";
+        ALOG_CONTEXT("req", 42);
+        ALog::ScopedContext userContext("user", user);
+        user = "changed";
+
+        LOGI << "Inner";
+
+        std::thread([&](){ LOGI << "Other thread"; }).join();
+    }
+
+    LOGI << "After";
+    ALOGGER_DIRECT->flush();
+
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_FALSE(records[0].context);
+    EXPECT_FALSE(records[2].context);
+    EXPECT_FALSE(records[3].context);
+
+    std::vector<std::string> keys;
+    records[1].forEachContext([&keys](const ALog::Record::Field& f){ keys.emplace_back(f.name); });
+    EXPECT_EQ(keys, (std::vector<std::string>{"req", "user"}));
+
+    const auto text = ALog::Formatters::Default().format(records[1]);
+    EXPECT_NE(std::string(text.begin(), text.end()).find(R"(Inner {req=42, user="bob"})"), std::string::npos);
+}
+
+TEST(ALog, test_scoped_verbosity)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set({
+        std::make_shared<ALog::Filters::SeverityModule>(ALog::Severity::Error, "Noisy"),
+        std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info)
+    });
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    LOGD << "Dropped 1";
+
+    {
+        ALog::ScopedVerbosity verbosity(ALog::Severity::Debug);
+        LOGD << "Passed 1";
+        LOGV << "Dropped 2";
+
+        {
+            DEFINE_ALOGGER_MODULE(Noisy);
+            LOGW << "Passed 2";
+        }
+
+        std::thread([&](){ LOGD << "Dropped 3"; }).join();
+    }
+
+    LOGD << "Dropped 4";
+
+    std::vector<std::string> messages;
+    for (const auto& x : records)
+        messages.emplace_back(x.getMessage());
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"Passed 1", "Passed 2"}));
+}
+
+TEST(ALog, test_backtrace)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info));
+    ALOGGER_DIRECT->setBacktrace(3);
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    for (int i = 1; i <= 5; i++)
+        LOGD << "D" << i;
+
+    LOGI << "Info";
+    LOGE << "Error 1";
+    LOGV << "V6";
+    LOGE << "Error 2";
+    LOGE << "Error 3";
+    LOGD << "D7";
+    LOGW << "Warning";
+
+    ALOGGER_DIRECT->setBacktrace(0);
+    LOGD << "D8";
+    LOGE << "Error 4";
+
+    std::vector<std::string> messages;
+    std::vector<std::string> backtrace;
+    for (const auto& x : records) {
+        messages.emplace_back(x.getMessage());
+        if (x.hasFlags(ALog::Record::Flags::Backtrace))
+            backtrace.emplace_back(x.getMessage());
+    }
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"Info", "D3", "D4", "D5", "Error 1", "V6", "Error 2", "Error 3", "Warning", "Error 4"}));
+    EXPECT_EQ(backtrace, (std::vector<std::string>{"D3", "D4", "D5", "V6"}));
+
+    ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+    ALOGGER_DIRECT->setBacktrace(2, ALog::Severity::Warning);
+    records.clear();
+
+    LOGD << "D1";
+    LOGD << LAZY([]{ return "D2"; });
+    LOGW << "Warning";
+    ALOGGER_DIRECT->flush();
+
+    messages.clear();
+    for (const auto& x : records)
+        messages.emplace_back(x.getMessage());
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"D1", "D2", "Warning"}));
+
+    // Running asynchronous logger keeps queued records
+    records.clear();
+    LOGI << "Queued";
+    ALOGGER_DIRECT->setBacktrace(0);
+    LOGD << "D3";
+    LOGW << "Warning 2";
+    ALOGGER_DIRECT->flush();
+
+    messages.clear();
+    for (const auto& x : records)
+        messages.emplace_back(x.getMessage());
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"Queued", "Warning 2"}));
+}
+
+namespace {
+int siteTestDebugLine {};
+
+void siteTestFunc(int i)
+{
+    siteTestDebugLine = __LINE__; LOGMD << "D" << i;
+    LOGMI << "I" << i;
+}
+
+void siteTestLateFunc(int& evaluations)
+{
+    LOGMI << "Late" << ++evaluations;
+}
+} // namespace
+
+TEST(ALog, test_sites)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogSitesTest);
+
+    ALog::Sites::reset();
+
+    siteTestFunc(1);
+
+    std::vector<ALog::Sites::Info> sites;
+    for (const auto& x : ALog::Sites::list())
+        if (!strcmp(x.func, "siteTestFunc"))
+            sites.push_back(x);
+
+    ASSERT_EQ(sites.size(), 2);
+    EXPECT_EQ(sites[0].line, siteTestDebugLine);
+    EXPECT_EQ(sites[0].module, nullptr);
+    EXPECT_STREQ(sites[0].file, __FILE__);
+    EXPECT_EQ(sites[0].state, ALog::SiteState::Default);
+
+    EXPECT_EQ(ALog::Sites::set("func siteTest?unc line " + std::to_string(siteTestDebugLine), ALog::SiteState::Enabled), 1);
+    siteTestFunc(2);
+
+    EXPECT_EQ(ALog::Sites::set("file *test3_*.cpp func siteTestFunc", ALog::SiteState::Disabled), 2);
+    siteTestFunc(3);
+
+    int evaluations = 0;
+    EXPECT_EQ(ALog::Sites::set("func siteTestLate*", ALog::SiteState::Disabled), 0);
+    siteTestLateFunc(evaluations);
+    EXPECT_EQ(evaluations, 0);
+
+    LOGI << "Module 1";
+    LOGF << "Fatal 1";
+    EXPECT_GE(ALog::Sites::set("module ALogSites*", ALog::SiteState::Disabled), 1);
+    LOGI << "Module 2";
+    LOGF << "Fatal 2";
+
+    EXPECT_THROW(ALog::Sites::set("bogus x", ALog::SiteState::Enabled), std::invalid_argument);
+    EXPECT_THROW(ALog::Sites::set("file", ALog::SiteState::Enabled), std::invalid_argument);
+    EXPECT_THROW(ALog::Sites::set("line x", ALog::SiteState::Enabled), std::invalid_argument);
+
+    ALog::Sites::reset();
+    siteTestFunc(4);
+    siteTestLateFunc(evaluations);
+
+    std::vector<std::string> messages;
+    for (const auto& x : records)
+        messages.emplace_back(x.getMessage());
+
+    EXPECT_EQ(messages, (std::vector<std::string>{"I1", "D2", "I2", "Module 1", "Fatal 1", "Fatal 2", "I4", "Late1"}));
+}
+
+TEST(ALog, test_batch)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    const auto messages = [&records](){
+        std::vector<std::string> result;
+        for (const auto& x : records)
+            result.emplace_back(x.getMessage());
+        records.clear();
+        return result;
+    };
+
+    ALog::Batch batch;
+    int evaluations = 0;
+    ALOG_BATCH(batch, ALog::Severity::Info) << "A";
+    ALOG_BATCH(batch, ALog::Severity::Debug) << "Filtered" << LAZY([&]{ return ++evaluations; });
+    ALOG_BATCH(batch, ALog::Severity::Warning) << "B" << LAZY([&]{ return ++evaluations; });
+    EXPECT_EQ(batch.size(), 3);
+    EXPECT_EQ(evaluations, 2);
+
+    ACCESS_ALOGGER_MODULE += std::move(batch);
+    EXPECT_TRUE(batch.empty());
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[1].module, "ALogTest");
+    EXPECT_EQ(messages(), (std::vector<std::string>{"A", "B2"}));
+
+    ALOG_BATCH(batch, ALog::Severity::Info) << "C";
+    ALOG_BATCH(batch, ALog::Severity::Error) << "D" << THROW;
+    ALOG_BATCH(batch, ALog::Severity::Info) << "Discarded";
+    EXPECT_THROW(*ALOGGER_DIRECT += std::move(batch), std::runtime_error);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(messages(), (std::vector<std::string>{"C", "D"}));
+
+    // Pending signal records and aggregates are written ahead of batch
+    ALOGGER_DIRECT->setSignalSlots(2);
+    ALOGGER_DIRECT->setAggregation(std::chrono::milliseconds(1));
+    LOGW_SIGNAL << "Signal";
+    LOG_AGGREGATE("batch-latency", 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ALOG_BATCH(batch, ALog::Severity::Info) << "E";
+    ACCESS_ALOGGER_MODULE += std::move(batch);
+    EXPECT_EQ(messages(), (std::vector<std::string>{"Signal", "batch-latency", "E"}));
+    ALOGGER_DIRECT->setAggregation({});
+    ALOGGER_DIRECT->setSignalSlots(0);
+
+    ALOGGER_DIRECT->setMode(ALog::Logger::AsynchronousSort);
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100; i++) {
+        ALOG_BATCH(batch, ALog::Severity::Info) << "Item " << i;
+        expected.push_back("Item " + std::to_string(i));
+    }
+    ALOG_BATCH(batch, ALog::Severity::Info) << "Last" << FLUSH;
+    expected.emplace_back("Last");
+
+    ACCESS_ALOGGER_MODULE += std::move(batch);
+    EXPECT_EQ(messages(), expected);
+}
+
+namespace EnumTest {
+enum class Color { Red, Green = 5, Blue };
+enum Plain : int { PlainA = -2, PlainB, PlainC = 100 };
+enum class Sparse : uint64_t { Small = 1, Huge = 0xFFFF000000000000ull };
+enum class NotNamed { X };
+} // namespace EnumTest
+
+ALOG_ENUM_NAMES(EnumTest::Color, {EnumTest::Color::Red, "Red"}, {EnumTest::Color::Green, "Green"}, {EnumTest::Color::Blue, "Blue"});
+ALOG_ENUM_NAMES(EnumTest::Sparse, {EnumTest::Sparse::Small, "Small"}, {EnumTest::Sparse::Huge, "Huge"});
+ALOG_ENUM_REFLECT(EnumTest::Plain, -2, 100);
+
+TEST(ALog, test_enum_names)
+{
+    auto record = ALOG_RECORD_IMPL(ALog::Severity::Info) << EnumTest::Color::Green;
+    EXPECT_STREQ(record.getMessage(), "EnumTest::Color(5, Green)");
+    EXPECT_EQ(record.severity, ALog::Severity::Info);
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << static_cast<EnumTest::Color>(3);
+    EXPECT_STREQ(record.getMessage(), "EnumTest::Color(3, out-of-range)");
+    EXPECT_EQ(record.severity, ALog::Severity::Warning);
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << EnumTest::Sparse::Huge << EnumTest::Sparse::Small;
+    EXPECT_STREQ(record.getMessage(), "EnumTest::Sparse(18446462598732840960, Huge)EnumTest::Sparse(1, Small)");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << EnumTest::NotNamed::X;
+    EXPECT_STREQ(record.getMessage(), "0");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info).seps() << EnumTest::PlainA << EnumTest::PlainB << EnumTest::PlainC << static_cast<EnumTest::Plain>(7);
+    EXPECT_STREQ(record.getMessage(), "EnumTest::Plain(-2, PlainA) EnumTest::Plain(-1, PlainB) EnumTest::Plain(100, PlainC) EnumTest::Plain(7, out-of-range)");
+}
+
+static std::string streamTestInner(int value);
+
+namespace StreamTest {
+struct Point { int x; int y; };
+struct Hexed { int value; };
+struct Nested { int value; };
+
+std::ostream& operator<<(std::ostream& os, const Point& value) { return os << "Point(" << value.x << ", " << value.y << ")"; }
+std::ostream& operator<<(std::ostream& os, const Hexed& value) { return os << std::hex << std::showbase << value.value; }
+std::ostream& operator<<(std::ostream& os, const Nested& value)
+{
+    return os << "Nested[" << streamTestInner(value.value) << "]";
+}
+} // namespace StreamTest
+
+static std::string streamTestInner(int value)
+{
+    auto record = ALOG_RECORD_IMPL(ALog::Severity::Info) << StreamTest::Point{value, value};
+    return record.getMessage();
+}
+
+TEST(ALog, test_ostream_fallback)
+{
+    static_assert(ALog::I::is_ostream_fallback<StreamTest::Point>::value);
+    static_assert(!ALog::I::is_ostream_fallback<int>::value);
+    static_assert(!ALog::I::is_ostream_fallback<std::string>::value);
+    static_assert(!ALog::I::is_ostream_fallback<const char*>::value);
+
+    auto record = ALOG_RECORD_IMPL(ALog::Severity::Info) << "At" << StreamTest::Point{1, 2} << "!";
+    EXPECT_STREQ(record.getMessage(), "AtPoint(1, 2)!");
+
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info).seps() << "At" << StreamTest::Point{1, 2} << 3;
+    EXPECT_STREQ(record.getMessage(), "At Point(1, 2) 3");
+
+    // Formatting state doesn't leak to next argument
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << StreamTest::Hexed{255} << "," << StreamTest::Point{10, 11};
+    EXPECT_STREQ(record.getMessage(), "0xff,Point(10, 11)");
+
+    // Logging from user's operator<<
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << StreamTest::Nested{7};
+    EXPECT_STREQ(record.getMessage(), "Nested[Point(7, 7)]");
+
+    // Long output
+    const std::string longText(300, 'z');
+    record = ALOG_RECORD_IMPL(ALog::Severity::Info) << std::string_view(longText) << StreamTest::Point{0, 0};
+    EXPECT_EQ(std::string(record.getMessage()), longText + "Point(0, 0)");
+}
+
+TEST(ALog, test_record_handles)
+{
+    std::vector<ALog::RecordHandle> retained1;
+    std::vector<ALog::RecordHandle> retained2;
+    std::vector<std::string> direct;
+
+    auto sinkDirect = std::make_shared<ALog::Sinks::Functor2>([&direct](const ALog::Buffer&, const ALog::Record& rec){ direct.emplace_back(rec.getMessage()); });
+    auto sinkHandle1 = std::make_shared<ALog::Sinks::HandleFunctor1>([&retained1](const ALog::RecordHandle& handle){ retained1.push_back(handle); });
+    auto sinkHandle2 = std::make_shared<ALog::Sinks::HandleFunctor1>([&retained2](const ALog::RecordHandle& handle){ retained2.push_back(handle); });
+
+    {
+        DEFINE_MAIN_ALOGGER;
+        ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+        ALOGGER_DIRECT->pipeline().sinks().set({sinkDirect, sinkHandle1, sinkHandle2});
+        ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+        ALOGGER_DIRECT.markReady();
+        DEFINE_ALOGGER_MODULE(ALogTest);
+
+        EXPECT_TRUE(ALOGGER_DIRECT->pipeline().sinks().acceptsHandles());
+
+        LOGI << "First";
+        LOGW << "Second";
+        ALOGGER_DIRECT->flush();
+    }
+
+    EXPECT_EQ(direct, (std::vector<std::string>{"First", "Second"}));
+    ASSERT_EQ(retained1.size(), 2);
+    ASSERT_EQ(retained2.size(), 2);
+
+    for (size_t i = 0; i < 2; i++) {
+        EXPECT_EQ(&retained1[i].record(), &retained2[i].record());
+        EXPECT_EQ(retained1[i].useCount(), 2);
+        EXPECT_STREQ(retained1[i].record().getMessage(), direct[i].c_str());
+        EXPECT_EQ(std::string(retained1[i].buffer().begin(), retained1[i].buffer().end()), direct[i]);
+    }
+
+    EXPECT_EQ(retained1[1].record().severity, ALog::Severity::Warning);
+
+    retained2.clear();
+    EXPECT_EQ(retained1[0].useCount(), 1);
+
+    auto copy = retained1[0];
+    auto moved = std::move(retained1[0]);
+    EXPECT_FALSE(retained1[0]);
+    EXPECT_EQ(moved.useCount(), 2);
+    EXPECT_STREQ(copy.record().getMessage(), "First");
+
+    ALog::Sinks::Chain chain({sinkDirect});
+    EXPECT_FALSE(chain.acceptsHandles());
+}
+
+TEST(ALog, test_hash_sample)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::HashSample>(0.25));
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    EXPECT_EQ(ALOGGER_DIRECT->pipeline().filters().dependencies(), ALog::IFilter::DependsOnSampleKey);
+
+    constexpr uint64_t keys = 10000;
+    size_t kept {};
+
+    for (uint64_t key = 0; key < keys; key++) {
+        const auto keep = ALog::Filters::HashSample::keep(key, 0.25);
+        kept += keep;
+
+        // All records of key pass or drop together
+        records.clear();
+        LOGI << "Begin" << SAMPLE_KEY(key);
+        LOGI << "End" << SAMPLE_KEY(key);
+        ASSERT_EQ(records.size(), keep ? 2 : 0);
+        if (keep) {
+            EXPECT_EQ(records[0].sampleKey, key);
+        }
+    }
+
+    EXPECT_NEAR(static_cast<double>(kept) / keys, 0.25, 0.02);
+
+    // Another seed selects another subset
+    size_t same {};
+    for (uint64_t key = 0; key < keys; key++)
+        same += ALog::Filters::HashSample::keep(key, 0.25) && ALog::Filters::HashSample::keep(key, 0.25, 1);
+    EXPECT_LT(same, kept / 2);
+
+    EXPECT_TRUE(ALog::Filters::HashSample::keep(123, 1));
+    EXPECT_FALSE(ALog::Filters::HashSample::keep(123, 0));
+
+    // Records without key are not affected
+    records.clear();
+    LOGI << "No key";
+    EXPECT_EQ(records.size(), 1);
+}
+
+TEST(ALog, test_filters_regex)
+{
+    const char* patterns[] = {
+        "abc", "a|bc|", "^ab", "ab$", "^a*$", "a+b?c{2}", "(ab|ba){1,3}x", "[a-c][^abc]", "x\\d+", "\\w\\s\\W",
+        "(?:a|b)*c", "[-a]{2,}", "c.c", "b{0}a", "^$", "a{2}|^x|y$", "[\\d\\]x]", "\\x61\\.", "A[B-X]"
+    };
+
+    // Random strings over small alphabet, compared to std::regex
+    const char alphabet[] = "abcxyABCXY0123 .-_]";
+    uint32_t seed = 4321;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+    std::vector<std::string> strings {""};
+    for (int i = 0; i < 1000; i++) {
+        std::string str(next() % 10, ' ');
+        for (auto& c : str) c = alphabet[next() % (sizeof(alphabet) - 1)];
+        strings.push_back(str);
+    }
+
+    for (const auto pattern : patterns) {
+        for (const bool caseSensitive : {true, false}) {
+            const ALog::Filters::Regex filter(pattern, true, caseSensitive);
+            const std::regex expected(pattern, caseSensitive ? std::regex::ECMAScript : std::regex::ECMAScript | std::regex::icase);
+
+            for (const auto& x : strings)
+                EXPECT_EQ(filter.matches(x.data(), x.size()), std::regex_search(x, expected)) << pattern << " : '" << x << "'";
+        }
+    }
+
+    // Brace without bounds is literal
+    EXPECT_TRUE(ALog::Filters::Regex("x{a}").matches("x{a}", 4));
+
+    // Unsupported or malformed
+    for (const auto pattern : {"(ab", "ab)", "[ab", "*a", "a{3,2}", "\\1", "\\b", "(?=a)", "a\\", "^*", "a{1001}"})
+        EXPECT_THROW(ALog::Filters::Regex{pattern}, std::invalid_argument) << pattern;
+
+    // Through logger
+    std::vector<std::string> records;
+
+    DEFINE_MAIN_ALOGGER;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec.getMessage()); });
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Regex>("^(GET|POST) /api/v[0-9]+/", false));
+    ALOGGER_DIRECT->setMode(ALog::Logger::LoggerMode::Synchronous);
+    MARK_ALOGGER_READY;
+
+    DEFINE_ALOGGER_MODULE(RegexTest);
+
+    LOGD << "GET /api/v2/users";
+    LOGD << "GET /static/app.js";
+    LOGD << "POST /api/v10/orders";
+    LOGD << "Started";
+
+    EXPECT_EQ(records, (std::vector<std::string>{"GET /static/app.js", "Started"}));
+}
+
+TEST(ALog, test_filters_compiled)
+{
+    auto createFilters = [](bool compilable) {
+        auto result = ALog::Filters::Chain::create({
+            std::make_shared<ALog::Filters::SeverityFile>(ALog::Severity::Error, "special.cpp", ALog::IFilter::PassOrUndefined),
+            std::make_shared<ALog::Filters::SeverityModule>(ALog::Severity::Warning, "module1", ALog::IFilter::PassOrReject),
+            std::make_shared<ALog::Filters::Module>("module2", false, ALog::IFilter::RejectOrUndefined),
+            std::make_shared<ALog::Filters::File>("hidden.cpp", false, ALog::IFilter::RejectOrUndefined),
+            std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info)
+        });
+
+        // Functor is never compiled; undefined decision keeps semantics
+        if (!compilable)
+            result->add(std::make_shared<ALog::Filters::Functor2>([](const ALog::Record&) -> ALog::I::optional_bool { return {}; }));
+
+        result->setDefaultDecision(false);
+        return result;
+    };
+
+    const auto compiled = createFilters(true);
+    const auto regular = createFilters(false);
+
+    const char* modules[] = {nullptr, "module1", "module2", "module3"};
+    const char* files[] = {"special.cpp", "hidden.cpp", "other.cpp"};
+
+    for (auto module : modules) {
+        for (auto file : files) {
+            for (int severity = ALog::Severity::Minimal; severity <= ALog::Severity::Maximal; severity++) {
+                auto record = ALog::Record::create(static_cast<ALog::Severity>(severity), 1, file, file, "");
+                record.module = module;
+
+                // Not interned: evaluated as usual
+                const auto expected = regular->canPass(record).value();
+                EXPECT_EQ(compiled->canPass(record).value(), expected);
+
+                // Interned, as by logging macros
+                record.moduleId = ALog::I::internModule(module);
+                record.fileId = ALog::I::internFile(file);
+                EXPECT_EQ(compiled->canPass(record).value(), expected);
+
+                // Verbosity override
+                record.verbosity = ALog::Severity::Minimal;
+                EXPECT_EQ(compiled->canPass(record).value(), regular->canPass(record).value());
+            }
+        }
+    }
+
+    // Recompiled on change
+    compiled->clear();
+    auto record = ALog::Record::create(ALog::Severity::Debug, 1, "other.cpp", "other.cpp", "");
+    record.fileId = ALog::I::internFile("other.cpp");
+    EXPECT_TRUE(compiled->canPass(record).value_or(false));
+    compiled->setDefaultDecision(false);
+    EXPECT_FALSE(compiled->canPass(record).value_or(true));
+
+    // Nested chain changed after being added
+    auto nested = ALog::Filters::Chain::create({std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info)});
+    auto outer = ALog::Filters::Chain::create({
+        std::make_shared<ALog::Filters::SeverityModule>(ALog::Severity::Warning, "module1"),
+        nested
+    });
+    EXPECT_FALSE(outer->canPass(record).value());
+    nested->set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Debug));
+    EXPECT_TRUE(outer->canPass(record).value());
+    nested->clear();
+    nested->setDefaultDecision(false);
+    EXPECT_FALSE(outer->canPass(record).value());
+    nested->add(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Verbose));
+    EXPECT_TRUE(outer->canPass(record).value());
+
+    // Through logger
+    std::vector<std::string> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec.getMessage()); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().filters().set(ALog::Filters::Chain::create({
+        std::make_shared<ALog::Filters::SeverityModule>(ALog::Severity::Warning, "module1"),
+        std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info)
+    }));
+    ALOGGER_DIRECT.markReady();
+
+    LOGMD << "main-debug";
+    LOGMI << "main-info";
+
+    {
+        DEFINE_ALOGGER_MODULE(module1);
+        LOGI << "module1-info";
+        LOGW << "module1-warning";
+
+        ALog::ScopedVerbosity verbosity(ALog::Severity::Minimal);
+        LOGD << "module1-verbose";
+    }
+
+    {
+        DEFINE_ALOGGER_MODULE(module3);
+        LOGD << "module3-debug";
+        LOGI << "module3-info";
+    }
+
+    EXPECT_EQ(records, (std::vector<std::string>{"main-info", "module1-warning", "module1-verbose", "module3-info"}));
+}
+
+namespace {
+class CountingSeverityFilter : public ALog::IFilter
+{
+public:
+    int dependencies() const override { return DependsOnSeverity; }
+
+    mutable std::atomic<int> calls {};
+    mutable std::atomic<bool> otherThread {};
+    std::thread::id thread {std::this_thread::get_id()};
+
+protected:
+    ALog::I::optional_bool canPassImpl(const ALog::Record& record) const override {
+        calls++;
+        if (std::this_thread::get_id() != thread) otherThread = true;
+        return record.reachesSeverity(ALog::Severity::Info);
+    }
+};
+} // namespace
+
+TEST(ALog, test_producer_filtering)
+{
+    std::vector<std::string> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec.getMessage()); });
+    auto filter = std::make_shared<CountingSeverityFilter>();
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+    ALOGGER_DIRECT->setProducerFiltering();
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().filters().set(filter);
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    auto logAll = [&](){
+        for (int i = 0; i < 10; i++) {
+            LOGD << "debug" << i;
+            LOGI << "info" << i;
+        }
+    };
+
+    // Verdict is computed once per site and severity
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(filter->calls, 2);
+    EXPECT_FALSE(filter->otherThread);
+    ASSERT_EQ(records.size(), 10);
+    EXPECT_EQ(records[0], "info0");
+
+    // Configuration change invalidates cached verdicts
+    ALOGGER_DIRECT->pipeline().sinks().add(std::make_shared<ALog::Sinks::Functor2>([](const ALog::Buffer&, const ALog::Record&){}));
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(filter->calls, 4);
+    EXPECT_EQ(records.size(), 20);
+
+    // Thread verbosity override isn't cached
+    {
+        ALog::ScopedVerbosity verbosity(ALog::Severity::Debug);
+        LOGD << "verbose";
+        LOGD << "verbose";
+    }
+    LOGD << "hidden";
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(records.size(), 22);
+    EXPECT_EQ(records.back(), "verbose");
+
+    // Message-dependent filters are evaluated in producer thread, without caching
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Substring>("keep"));
+    LOGD << "keep 1";
+    LOGD << "drop";
+    LOGD << "keep 2";
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(records.size(), 24);
+    EXPECT_EQ(records.back(), "keep 2");
+
+    // Default decision change invalidates cached verdicts
+    ALOGGER_DIRECT->pipeline().filters().set(std::make_shared<ALog::Filters::Severity>(ALog::Severity::Info, ALog::IFilter::PassOrUndefined));
+    ALOGGER_DIRECT->pipeline().filters().setDefaultDecision(false);
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(records.size(), 34);
+
+    ALOGGER_DIRECT->pipeline().filters().setDefaultDecision(true);
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(records.size(), 54);
+
+    ALOGGER_DIRECT->pipeline().filters().setDefaultDecision(false);
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(records.size(), 64);
+
+    // Disabled: filters run in logger thread again
+    ALOGGER_DIRECT->setProducerFiltering(false);
+    ALOGGER_DIRECT->pipeline().filters().set(filter);
+    filter->calls = 0;
+    logAll();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(filter->calls, 20);
+    EXPECT_TRUE(filter->otherThread);
+    EXPECT_EQ(records.size(), 74);
+}
+
+TEST(ALog, test_config)
+{
+    // Parsing
+    const auto config = ALog::Config::parse(
+        "; Comment\n"
+        "[logger]\n"
+        "mode = async\n"
+        "producer_filtering = yes\n"
+        "\n"
+        "[levels]\n"
+        "default = warning\n"
+        "Network = Debug\n"
+        "\n"
+        "[filters]\n"
+        "reject = heartbeat, , ping \n"
+        "reject_regex = ^poll #[0-9]+$\n"
+        "\n"
+        "[formatter]\n"
+        "type = json\n"
+        "\n"
+        "[sink.err]\n"
+        "type = console\n"
+        "stream = stderr\n"
+        "colors = disable\n"
+        "\n"
+        "[sink.main]\n"
+        "type = file_rotated\n"
+        "path = logs/app.log\n"
+        "max_size = 1024\n"
+        "max_count = 3\n");
+
+    ASSERT_TRUE(config.mode.has_value());
+    EXPECT_EQ(*config.mode, ALog::Logger::Asynchronous);
+    EXPECT_FALSE(config.autoflush.has_value());
+    EXPECT_TRUE(config.producerFiltering.value_or(false));
+    EXPECT_EQ(config.defaultLevel.value_or(ALog::Severity::Minimal), ALog::Severity::Warning);
+    ASSERT_EQ(config.moduleLevels.size(), 1);
+    EXPECT_EQ(config.moduleLevels[0].first, "Network");
+    EXPECT_EQ(config.moduleLevels[0].second, ALog::Severity::Debug);
+    EXPECT_EQ(config.reject, (std::vector<std::string>{"heartbeat", "ping"}));
+    EXPECT_EQ(config.rejectRegex, "^poll #[0-9]+$");
+    EXPECT_EQ(config.formatter, ALog::Config::FormatterType::Json);
+    ASSERT_EQ(config.sinks.size(), 2);
+    EXPECT_EQ(config.sinks[0].stream, ALog::Sinks::Console::Stream::StdErr);
+    EXPECT_EQ(config.sinks[0].colors, ALog::Sinks::Console::ColorMode::Disable);
+    EXPECT_EQ(config.sinks[1].type, ALog::Config::Sink::Type::FileRotated);
+    EXPECT_EQ(config.sinks[1].path, "logs/app.log");
+    EXPECT_EQ(config.sinks[1].maxSize.value_or(0), 1024);
+    EXPECT_FALSE(config.sinks[1].maxAge.has_value());
+    EXPECT_EQ(config.sinks[1].maxCount.value_or(0), 3);
+
+    EXPECT_THROW(ALog::Config::parse("[unknown]"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[levels"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("default = info"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[levels]\ndefault info"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[levels]\ndefault = loud"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[logger]\nspeed = 1"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[sink.a]\nmax_size = -1"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[sink.a]\ntype = file"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::parse("[sink.a]\n[sink.a]"), std::invalid_argument);
+    EXPECT_THROW(ALog::Config::load("alog-missing-config.ini"), std::runtime_error);
+
+    try {
+        ALog::Config::parse("[levels]\n\ndefault = loud");
+        FAIL();
+    } catch (const std::invalid_argument& e) {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos);
+    }
+
+    // Applying and hot reload
+    const std::string sandboxFolder = "alog-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::filesystem::create_directory(sandboxFolder); // throws
+    const auto _undo_create_directory = ALog::Internal::CreateFinally([sandboxFolder](){ std::filesystem::remove_all(sandboxFolder); });
+
+    const auto configFile = sandboxFolder + "/alog.ini";
+    const auto logFile = sandboxFolder + "/out.log";
+
+    const auto writeConfig = [&](const std::string& moduleLevel){
+        std::ofstream(configFile + ".tmp") << "[logger]\nmode = async\n"
+                                              "[levels]\ndefault = warning\nALogTest = " << moduleLevel << "\n"
+                                              "[filters]\nreject = secret\n"
+                                              "[formatter]\ntype = minimal\n"
+                                              "[sink.main]\ntype = file\npath = " << logFile << "\n";
+        std::filesystem::rename(configFile + ".tmp", configFile);
+    };
+
+    const auto readLog = [&](){
+        std::ifstream file(logFile);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line); )
+            lines.push_back(line);
+        return lines;
+    };
+
+    const auto waitFor = [](const auto& predicate){
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!predicate() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return predicate();
+    };
+
+    writeConfig("info");
+
+    DEFINE_MAIN_ALOGGER;
+    ALog::Config::load(configFile).apply(*ALOGGER_DIRECT);
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    LOGI << "info1";
+    LOGD << "debug1";
+    LOGI << "secret";
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(readLog(), (std::vector<std::string>{"info1"}));
+
+    std::atomic<int> errors {};
+    ALog::ConfigWatcher watcher(*ALOGGER_DIRECT, configFile, [&errors](const std::string&){ errors++; }, std::chrono::milliseconds(10));
+
+    writeConfig("debug");
+    ASSERT_TRUE(waitFor([&](){ return watcher.reloads() == 1; }));
+    LOGD << "debug2";
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(readLog(), (std::vector<std::string>{"info1", "debug2"}));
+
+    // Malformed file is ignored
+    std::ofstream(configFile) << "[levels]\ndefault = loud\n";
+    ASSERT_TRUE(waitFor([&](){ return errors > 0; }));
+    EXPECT_EQ(watcher.reloads(), 1);
+    LOGD << "debug3";
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(readLog().size(), 3);
+
+    // Records logged concurrently with reloads aren't lost
+    writeConfig("debug");
+    ASSERT_TRUE(waitFor([&](){ return watcher.reloads() == 2; }));
+
+    std::thread producer([&](){
+        for (int i = 0; i < 2000; i++)
+            LOGD << "record";
+    });
+
+    for (int i = 0; i < 5; i++)
+        EXPECT_TRUE(watcher.reload());
+
+    producer.join();
+    ALOGGER_DIRECT->flush();
+    EXPECT_EQ(readLog().size(), 2003);
+    EXPECT_EQ(errors, 1);
+
+    // Exception of error handler doesn't escape
+    std::ofstream(configFile) << "[levels]\ndefault = loud\n";
+    ALog::ConfigWatcher throwing(*ALOGGER_DIRECT, configFile, [](const std::string&){ throw std::runtime_error("Handler"); });
+    EXPECT_FALSE(throwing.reload());
+}
+
+TEST(ALog, test_prepared)
+{
+    std::vector<std::string> messages;
+    std::vector<int> lines;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&](const ALog::Buffer&, const ALog::Record& rec){
+        messages.emplace_back(rec.getMessage());
+        lines.push_back(rec.line);
+    });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    static const auto stmt = ALOG_PREPARE(Warning, "Order", _, "filled at", _, "(", 100, "%)");
+    EXPECT_EQ(stmt.severity(), ALog::Severity::Warning);
+
+    const std::string str = "abc";
+    const int line = __LINE__ + 1;
+    LOG_PREPARED(stmt, 17, 2.5);
+    LOG_PREPARED(stmt, str, "x") << "!";
+    LOGW << "Order" << str << "filled at" << "x" << "(" << 100 << "%)" << "!";
+    EXPECT_EQ(messages[0], "Order17filled at2.500000(100%)");
+    EXPECT_EQ(messages[1], messages[2]);
+    EXPECT_EQ(lines[0], line); // Location of LOG_PREPARED, not of ALOG_PREPARE
+
+    // Same output as regular statement, including empty arguments
+    const auto record1 = ALOG_PREPARE(Info, "a", _, "b", "c", _)
+        .at(__LINE__, __FILE__, "", __func__).record(std::string(), 5);
+    const auto record2 = ALOG_RECORD_IMPL(ALog::Severity::Info) << "a" << std::string() << "b" << "c" << 5;
+    EXPECT_STREQ(record1.getMessage(), record2.getMessage());
+
+    const auto stmtEmptyFirst = ALOG_PREPARE(Info, _, "tail");
+    EXPECT_STREQ(stmtEmptyFirst.at(__LINE__, __FILE__, "", __func__).record(std::string()).getMessage(), (ALOG_RECORD_IMPL(ALog::Severity::Info) << std::string() << "tail").getMessage());
+
+    const auto noArgs = ALOG_PREPARE(Error, "Only", "literals");
+    EXPECT_STREQ(noArgs.at(__LINE__, __FILE__, "", __func__).record().getMessage(), "Onlyliterals");
+    EXPECT_EQ(noArgs.at(__LINE__, __FILE__, "", __func__).record().severity, ALog::Severity::Error);
+}
+
+TEST(ALog, test_aggregate)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    for (int i = 1; i <= 100; i++)
+        LOG_AGGREGATE("latency", i);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&](){ for (int i = 0; i < 1000; i++) LOG_AGGREGATE("mt", 5); });
+    for (auto& x : threads) x.join();
+
+    ALOGGER_DIRECT->emitAggregates();
+    ASSERT_EQ(records.size(), 2);
+
+    EXPECT_STREQ(records[0].getMessage(), "latency");
+    EXPECT_STREQ(records[0].module, "ALogTest");
+    EXPECT_EQ(records[0].severity, ALog::Severity::Info);
+    EXPECT_EQ(records[0].findField("count")->value.u, 100);
+    EXPECT_EQ(records[0].findField("min")->value.d, 1);
+    EXPECT_EQ(records[0].findField("max")->value.d, 100);
+    EXPECT_EQ(records[0].findField("mean")->value.d, 50.5);
+    EXPECT_NEAR(records[0].findField("p99")->value.d, 99, 99 * 0.0625);
+
+    EXPECT_STREQ(records[1].getMessage(), "mt");
+    EXPECT_EQ(records[1].findField("count")->value.u, 4000);
+    EXPECT_EQ(records[1].findField("p99")->value.d, 5);
+
+    // Statistics are reset after emission
+    records.clear();
+    ALOGGER_DIRECT->emitAggregates();
+    EXPECT_TRUE(records.empty());
+
+    // Context and verbosity of emitting thread aren't attached
+    {
+        LOG_AGGREGATE("latency", 1);
+        ALOG_CONTEXT("req", 42);
+        ALog::ScopedVerbosity verbosity(ALog::Severity::Verbose);
+        ALOGGER_DIRECT->emitAggregates();
+    }
+
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_FALSE(records[0].context);
+    EXPECT_FALSE(records[0].verbosity);
+    records.clear();
+
+    // Periodic
+    ALOGGER_DIRECT->setAggregation(std::chrono::milliseconds(20), ALog::Severity::Debug);
+    LOG_AGGREGATE("latency", 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    LOGI << "Trigger";
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_STREQ(records[0].getMessage(), "latency");
+    EXPECT_EQ(records[0].severity, ALog::Severity::Debug);
+    EXPECT_EQ(records[0].findField("count")->value.u, 1);
+    EXPECT_STREQ(records[1].getMessage(), "Trigger");
+
+    records.clear();
+    ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+    LOG_AGGREGATE("latency", 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ALOGGER_DIRECT->flush();
+
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].findField("mean")->value.d, 4);
+
+    ALOGGER_DIRECT->setAggregation({});
+}
+
+#ifndef _WIN32
+namespace {
+void signalTestHandler(int)
+{
+    const char state[8] = {'r', 'e', 'a', 'd', 'y'};
+    ALOGMW_SIGNAL << "Signal:" << SIGUSR1 << ", state:" << state;
+}
+} // namespace
+#endif // _WIN32
+
+TEST(ALog, test_signal_safe)
+{
+    std::vector<std::string> messages;
+    std::vector<std::string> threads;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&](const ALog::Buffer&, const ALog::Record& rec){
+        messages.emplace_back(rec.getMessage());
+        threads.emplace_back(rec.threadTitle ? rec.threadTitle : "");
+    });
+
+    // Restricted record
+    auto record = ALog::SignalRecord::create(ALog::Severity::Info, 0, "", "", "") << "a" << -12 << 'c' << true << uint64_t(7);
+    EXPECT_EQ(std::string(record.message, record.messageLen), "a-12ctrue7");
+
+    const std::string longText(ALog::SignalRecord::message_limit + 10, 'x');
+    record = ALog::SignalRecord::create(ALog::Severity::Info, 0, "", "", "") << longText.c_str();
+    EXPECT_EQ(record.messageLen, ALog::SignalRecord::message_limit);
+
+    for (auto mode : {ALog::Logger::Synchronous, ALog::Logger::AsynchronousSort}) {
+        messages.clear();
+        threads.clear();
+
+        DEFINE_MAIN_ALOGGER;
+        ALOGGER_DIRECT->setMode(mode);
+        ALOGGER_DIRECT->pipeline().sinks().set(sink);
+        ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+        ALOGGER_DIRECT.markReady();
+        DEFINE_ALOGGER_MODULE(ALogTest);
+
+        // Disabled by default
+        EXPECT_FALSE(ALOGGER_DIRECT->addSignalRecord(ALog::SignalRecord::create(ALog::Severity::Info, 0, "", "", "")));
+
+        ALOGGER_DIRECT->setSignalSlots(2);
+        LOGI_SIGNAL << "First";
+        LOGW_SIGNAL << "Second";
+        LOGE_SIGNAL << "Dropped";
+        EXPECT_EQ(ALOGGER_DIRECT->droppedSignalRecords(), 1);
+
+        LOGI << "Regular";
+        ALOGGER_DIRECT->flush();
+
+        EXPECT_EQ(messages, (std::vector<std::string>{"First", "Second", "Regular"}));
+        EXPECT_EQ(threads, (std::vector<std::string>{"signal", "signal", ""}));
+
+#ifndef _WIN32
+        messages.clear();
+        const auto prevHandler = std::signal(SIGUSR1, signalTestHandler);
+        std::raise(SIGUSR1);
+        std::signal(SIGUSR1, prevHandler);
+
+        ALOGGER_DIRECT->flush();
+        EXPECT_EQ(messages, (std::vector<std::string>{"Signal:" + std::to_string(SIGUSR1) + ", state:ready"}));
+#endif // _WIN32
+    }
+}
+
+#ifdef ALOG_HAS_PMR
+namespace {
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::atomic<size_t> allocations {};
+    std::atomic<ptrdiff_t> outstanding {};
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        outstanding += static_cast<ptrdiff_t>(bytes);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        outstanding -= static_cast<ptrdiff_t>(bytes);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+} // namespace
+
+TEST(ALog, test_memory_resource)
+{
+    const std::string longText(500, 'x');
+    std::vector<std::string> messages;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&messages](const ALog::Buffer&, const ALog::Record& rec){ messages.emplace_back(rec.getMessage()); });
+
+#ifndef ALOG_HAS_PMR_BUFFER
+    // Sinks, formatters and converters keep using plain vector
+    static_assert(std::is_same_v<ALog::Buffer, std::vector<uint8_t>>);
+#endif // !ALOG_HAS_PMR_BUFFER
+
+    // Global
+    CountingResource global;
+    ALog::setMemoryResource(&global);
+    EXPECT_EQ(ALog::memoryResource(), &global);
+
+    {
+        DEFINE_MAIN_ALOGGER;
+        ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+        ALOGGER_DIRECT->pipeline().sinks().set(sink);
+        ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+        ALOGGER_DIRECT.markReady();
+        DEFINE_ALOGGER_MODULE(ALogTest);
+
+        LOGI << longText;
+#ifdef ALOG_HAS_PMR_BUFFER
+        EXPECT_GT(global.allocations.load(), 0);
+#endif // ALOG_HAS_PMR_BUFFER
+    }
+
+    ALog::setMemoryResource(nullptr);
+    EXPECT_EQ(ALog::memoryResource(), std::pmr::new_delete_resource());
+    EXPECT_EQ(global.outstanding.load(), 0);
+
+    // Logger-level
+    CountingResource local;
+    messages.clear();
+
+    {
+        DEFINE_MAIN_ALOGGER;
+        ALOGGER_DIRECT->setMode(ALog::Logger::Asynchronous);
+        ALOGGER_DIRECT->setBacktrace(4);
+        ALOGGER_DIRECT->setMemoryResource(&local);
+        ALOGGER_DIRECT->pipeline().sinks().set(sink);
+        ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+        ALOGGER_DIRECT.markReady();
+        DEFINE_ALOGGER_MODULE(ALogTest);
+
+        EXPECT_GT(local.allocations.load(), 0); // Backtrace ring
+        const auto before = local.allocations.load();
+
+        for (int i = 0; i < 10; i++)
+            LOGI << i;
+        ALOGGER_DIRECT->flush();
+
+        EXPECT_GT(local.allocations.load(), before); // Queue
+    }
+
+    EXPECT_EQ(local.outstanding.load(), 0);
+    EXPECT_EQ(messages, (std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"}));
+}
+#endif // ALOG_HAS_PMR
+
+#ifdef ALOG_HAS_STD_FORMAT
+TEST(ALog, test_format)
+{
+    std::vector<ALog::Record> records;
+    auto sink = std::make_shared<ALog::Sinks::Functor2>([&records](const ALog::Buffer&, const ALog::Record& rec){ records.push_back(rec); });
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->setMode(ALog::Logger::Synchronous);
+    ALOGGER_DIRECT->pipeline().sinks().set(sink);
+    ALOGGER_DIRECT->pipeline().formatter() = std::make_shared<ALog::Formatters::Minimal>();
+    ALOGGER_DIRECT.markReady();
+    DEFINE_ALOGGER_MODULE(ALogTest);
+
+    const std::string longText(100, 'x');
+
+    LOGI_FMT("x={} y={:.3f}", 5, 3.14159);
+    LOGMW_FMT("{}|{:>4}", longText, 7);
+    LOGI.seps() << "Value:" << ALog::I::makeFormat("{:#x}", 255) << "end";
+    LOGI << "prefix" << ALog::I::makeFormat("{}{}", longText, std::string(300, 'y')); // Longer than stack buffer
+
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_STREQ(records[0].getMessage(), "x=5 y=3.142");
+    EXPECT_EQ(std::string(records[1].getMessage()), longText + "|   7");
+    EXPECT_STREQ(records[2].getMessage(), "Value: 0xff end");
+    EXPECT_EQ(std::string(records[3].getMessage()), "prefix" + longText + std::string(300, 'y'));
+}
+#endif // ALOG_HAS_STD_FORMAT
+
 #ifdef ALOG_HAS_QT_LIBRARY
 // Test futures print: not started, running, canceled, finished, exception
 TEST(ALog, test_QFuture)
@@ -0,0 +1,13 @@
+# Verifies that binary built with ALOG_MIN_SEVERITY doesn't contain stripped messages
+# Usage: cmake -DBINARY=<path> -P check_stripped.cmake
+
+file(STRINGS "${BINARY}" KEPT REGEX "alog-kept-marker")
+file(STRINGS "${BINARY}" STRIPPED REGEX "alog-stripped-marker")
+
+if (NOT KEPT)
+    message(FATAL_ERROR "Kept messages are not found in ${BINARY}")
+endif()
+
+if (STRIPPED)
+    message(FATAL_ERROR "Stripped messages are found in ${BINARY}: ${STRIPPED}")
+endif()
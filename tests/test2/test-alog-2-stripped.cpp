@@ -0,0 +1,54 @@
+/* License:  MIT
+ * Source:   https://github.com/ihor-drachuk/alog
+ * Contact:  ihor-drachuk-libs@pm.me  */
+
+// Statements below Info are stripped in this translation unit.
+// 'check_stripped.cmake' additionally verifies stripped literals are absent in the binary.
+#undef ALOG_MIN_SEVERITY
+#define ALOG_MIN_SEVERITY 2
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <alog/all.h>
+
+int main()
+{
+    std::vector<std::string> messages;
+    int evaluated = 0;
+    auto evaluate = [&evaluated]() { return ++evaluated; };
+
+    DEFINE_MAIN_ALOGGER;
+    ALOGGER_DIRECT->pipeline().sinks().set(std::make_shared<ALog::Sinks::Functor2>([&messages](const ALog::Buffer&, const ALog::Record& rec){ messages.push_back(rec.getMessage()); }));
+    ALOGGER_DIRECT->setMode(ALog::Logger::LoggerMode::Synchronous);
+    MARK_ALOGGER_READY;
+
+    DEFINE_ALOGGER_MODULE(StrippedTest);
+
+    LOGV << "alog-stripped-marker-v1" << evaluate();
+    LOGD << "alog-stripped-marker-d1" << evaluate();
+    LOGD_IF(evaluate()) << "alog-stripped-marker-d2";
+    LOGMD << "alog-stripped-marker-d3" << evaluate();
+    LOGMV_IF(true).no_seps() << "alog-stripped-marker-v2" << evaluate();
+    LOGD_EVERY_N(2) << "alog-stripped-marker-d5" << evaluate();
+
+    static const auto strippedStmt = ALOG_PREPARE(Debug, "alog-stripped-marker-p1", _);
+    static const auto keptStmt = ALOG_PREPARE(Warning, "alog-kept-marker-p1", _);
+    LOG_PREPARED(strippedStmt, evaluate());
+    LOG_PREPARED(keptStmt, 1);
+
+    if (evaluated)
+        LOGD << "alog-stripped-marker-d4";
+    else
+        LOGI << "alog-kept-marker-i1" << evaluate();
+
+    LOGMW << "alog-kept-marker-w1";
+    LOG_ASSERT(evaluate() > 0);
+
+    if (evaluated != 2 || messages.size() != 3) {
+        std::printf("Unexpected result: evaluated %d, messages %d\n", evaluated, static_cast<int>(messages.size()));
+        return 1;
+    }
+
+    return 0;
+}